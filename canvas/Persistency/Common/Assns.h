@@ -67,8 +67,33 @@
 // Modifiers:
 //
 //   void swap(Assns& other);
+//   void reserve(size_type n);
 //   void addSingle(Ptr<L> const&, Ptr<R> const&); // Assns<L, R> only.
 //   void addSingle(Ptr<L> const&, Ptr<R> const&, D const&);
+//   void addSingle(Ptr<L> const&, Ptr<R> const&, D&&);
+//
+//   // Bulk insertion: associates, for each i, item leftKeys[i] of
+//   // leftProduct with item rightKeys[i] of rightProduct.  Each product
+//   // is given by an object, such as a handle, that provides id() and
+//   // productGetter(), or by a std::pair of a ProductID and a pointer
+//   // to an EDProductGetter; a bare ProductID is rejected, as the
+//   // Ptrs could not be dereferenced.  The Ptrs are made from these
+//   // (see Ptr constructor 3), without looking up the items; each
+//   // resolves its item through the getter on first dereference.  The
+//   // data, if any, are copied or moved in.  An art::Exception is
+//   // thrown, and nothing is added, if the numbers of keys and data
+//   // differ.
+//   template <typename LP, typename LKeys, typename RP, typename RKeys>
+//   void addMany(LP const& leftProduct,
+//                LKeys const& leftKeys,
+//                RP const& rightProduct,
+//                RKeys const& rightKeys);   // Assns<L, R> only.
+//   template <typename LP, typename LKeys, typename RP, typename RKeys>
+//   void addMany(LP const& leftProduct,
+//                LKeys const& leftKeys,
+//                RP const& rightProduct,
+//                RKeys const& rightKeys,
+//                std::vector<D>&& data);    // Or any container of D.
 //
 // Accessors:
 //
@@ -80,6 +105,24 @@
 //   D const& data(std::size_t index) const;
 //   D const& data(const_iterator it) const;
 //
+//   // The rows of the associations whose left (right) Ptrs refer to
+//   // product pid, by key (see detail/AssnsKeyIndex.h).  Built on
+//   // first use and kept until the Assns is modified.  See also
+//   // AssnsIndex.h.
+//   detail::AssnsKeyIndex const& leftKeyIndex(ProductID pid) const;
+//   detail::AssnsKeyIndex const& rightKeyIndex(ProductID pid) const;
+//
+////////////////////////////////////
+// Persistency.
+//////////
+//
+// From Class_Version 12 of Assns<L, R>, the Ptrs of each side are
+// persisted in packed form (see detail/PackedPtrData.h) when they can
+// be, and as before, as std::vector<std::pair<RefCore, std::size_t>>,
+// otherwise.  An Assns of an earlier version is read in the latter
+// form, and needs no I/O read rule; the dictionary for Assns must
+// provide one for art::detail::PackedPtrData.
+//
 ////////////////////////////////////////////////////////////////////////
 
 #include "canvas/Persistency/Common/types.h"
@@ -87,14 +130,21 @@
 #include "canvas/Persistency/Common/AssnsBase.h"
 #include "canvas/Persistency/Common/Ptr.h"
 #include "canvas/Persistency/Common/Wrapper.h"
+#include "canvas/Persistency/Common/detail/AssnsKeyIndex.h"
+#include "canvas/Persistency/Common/detail/PackedPtrData.h"
 #include "canvas/Persistency/Common/detail/throwPartnerException.h"
 #include "canvas/Utilities/Exception.h"
 #include "canvas/Utilities/TypeID.h"
+#include "canvas/Utilities/static_type_name.h"
 #include "cetlib/container_algorithms.h"
 #include "cetlib_except/demangle.h"
 
+#include <algorithm>
+#include <cassert>
 #include <iostream>
+#include <iterator>
 #include <typeinfo>
+#include <utility>
 #include <vector>
 
 namespace art {
@@ -113,8 +163,56 @@ namespace art {
   template <typename L, typename R>
   class Assns<L, R, void>; // No data: base class.
 
+  template <typename L, typename R, typename D>
+  struct static_type_name_traits<Assns<L, R, D>>
+    : detail::static_template_name_traits<L, R, D> {
+    static std::string
+    name()
+    {
+      return detail::static_template_name_traits<L, R, D>::name_of(
+        "art::Assns");
+    }
+  };
+
   namespace detail {
     class AssnsStreamer;
+
+    // The ID and getter of a product given by an object (e.g. a
+    // handle) that provides them, or by the pair of them.
+    template <typename P>
+    std::pair<ProductID, EDProductGetter const*>
+    assns_product(P const& product)
+    {
+      static_assert(!std::is_convertible_v<P, ProductID>,
+                    "A product must be given with its EDProductGetter: "
+                    "pass a handle or a std::pair<ProductID, "
+                    "EDProductGetter const*>.");
+      return {product.id(), product.productGetter()};
+    }
+
+    // The getter may be of any type derived from EDProductGetter, and
+    // need not be const.
+    template <typename G>
+    std::pair<ProductID, EDProductGetter const*>
+    assns_product(std::pair<ProductID, G*> const& product)
+    {
+      return {product.first, product.second};
+    }
+
+    // Throws if the numbers of keys, Ptrs or data given to addMany do
+    // not match.
+    inline void
+    check_assns_sizes(std::size_t const expected,
+                      std::size_t const actual,
+                      char const* what)
+    {
+      if (expected != actual) {
+        throw Exception(errors::LogicError, "Assns::addMany")
+          << "The number of " << what << " (" << actual
+          << ") differs from the number of associations (" << expected
+          << ").\n";
+      }
+    }
   }
 }
 
@@ -149,8 +247,11 @@ public:
   assn_t const& at(size_type index) const;
   size_type size() const;
   std::string className() const;
+  detail::AssnsKeyIndex const& leftKeyIndex(ProductID pid) const;
+  detail::AssnsKeyIndex const& rightKeyIndex(ProductID pid) const;
 
   // Modifiers.
+  void reserve(size_type n);
   void addSingle(Ptr<left_t> const& left, Ptr<right_t> const& right);
 
   template <typename Ls>
@@ -159,6 +260,12 @@ public:
   template <typename Rs>
   void addMany(Ptr<left_t> const& left, Rs const& rights);
 
+  template <typename LP, typename LKeys, typename RP, typename RKeys>
+  void addMany(LP const& leftProduct,
+               LKeys const& leftKeys,
+               RP const& rightProduct,
+               RKeys const& rightKeys);
+
   void swap(art::Assns<L, R, void>& other);
 
   std::unique_ptr<EDProduct> makePartner(
@@ -167,7 +274,7 @@ public:
   static short
   Class_Version()
   {
-    return 11;
+    return 12;
   }
 
   void
@@ -204,10 +311,22 @@ private:
 
   void fill_transients() override;
   void fill_from_transients() override;
+  // Fills packed_1_ and packed_2_, if the Ptrs can be packed.
+  bool pack_transients();
+
+  template <typename Side>
+  std::vector<std::size_t> keys_of(ProductID pid, Side side) const;
+  void clearKeyIndices() noexcept;
+  // Makes room for n more associations, keeping the growth geometric.
+  void grow_by(size_type n);
 
   ptrs_t ptrs_{}; //! transient
+  detail::AssnsKeyIndexCache leftKeyIndices_{};  //! transient
+  detail::AssnsKeyIndexCache rightKeyIndices_{}; //! transient
   ptr_data_t ptr_data_1_{};
   ptr_data_t ptr_data_2_{};
+  detail::PackedPtrData packed_1_{};
+  detail::PackedPtrData packed_2_{};
 };
 
 ////////////////////////////////////////////////////////////////////////
@@ -252,20 +371,51 @@ public:
 
   using base::operator[];
   using base::at;
+  using base::leftKeyIndex;
+  using base::rightKeyIndex;
 
   data_t const& data(typename std::vector<data_t>::size_type index) const;
   data_t const& data(const_iterator it) const;
 
   // Modifiers.
+  void reserve(size_type n);
   void addSingle(Ptr<left_t> const& left,
                  Ptr<right_t> const& right,
                  data_t const& data);
+  void addSingle(Ptr<left_t> const& left,
+                 Ptr<right_t> const& right,
+                 data_t&& data);
 
   template <typename Ls, typename Ds>
   void addMany(Ls const& lefts, Ptr<right_t> const& right, Ds const& data);
+  template <typename Ls>
+  void addMany(Ls const& lefts,
+               Ptr<right_t> const& right,
+               std::vector<data_t>&& data);
 
   template <typename Rs, typename Ds>
   void addMany(Ptr<left_t> const& left, Rs const& rights, Ds const& data);
+  template <typename Rs>
+  void addMany(Ptr<left_t> const& left,
+               Rs const& rights,
+               std::vector<data_t>&& data);
+
+  template <typename LP,
+            typename LKeys,
+            typename RP,
+            typename RKeys,
+            typename Ds>
+  void addMany(LP const& leftProduct,
+               LKeys const& leftKeys,
+               RP const& rightProduct,
+               RKeys const& rightKeys,
+               Ds const& data);
+  template <typename LP, typename LKeys, typename RP, typename RKeys>
+  void addMany(LP const& leftProduct,
+               LKeys const& leftKeys,
+               RP const& rightProduct,
+               RKeys const& rightKeys,
+               std::vector<data_t>&& data);
 
   void swap(art::Assns<L, R, D>& other);
 
@@ -291,6 +441,10 @@ private:
   std::unique_ptr<EDProduct> makePartner_(
     std::type_info const& wanted_wrapper_type) const override;
 
+  template <typename Ds>
+  void append_data(Ds const& data);
+  void append_data(std::vector<data_t>&& data);
+
   std::vector<data_t> data_;
 };
 
@@ -352,8 +506,64 @@ template <typename L, typename R>
 inline std::string
 art::Assns<L, R, void>::className() const
 {
-  TypeID const assns_type{typeid(Assns<L, R, void>)};
-  return assns_type.className();
+  return static_type_name<Assns<L, R, void>>();
+}
+
+template <typename L, typename R>
+art::detail::AssnsKeyIndex const&
+art::Assns<L, R, void>::leftKeyIndex(ProductID const pid) const
+{
+  return leftKeyIndices_.get(pid, [this, pid] {
+    return keys_of(pid, [](assn_t const& assn) -> auto& { return assn.first; });
+  });
+}
+
+template <typename L, typename R>
+art::detail::AssnsKeyIndex const&
+art::Assns<L, R, void>::rightKeyIndex(ProductID const pid) const
+{
+  return rightKeyIndices_.get(pid, [this, pid] {
+    return keys_of(pid,
+                   [](assn_t const& assn) -> auto& { return assn.second; });
+  });
+}
+
+template <typename L, typename R>
+template <typename Side>
+std::vector<std::size_t>
+art::Assns<L, R, void>::keys_of(ProductID const pid, Side side) const
+{
+  std::vector<std::size_t> keys(ptrs_.size(), detail::AssnsKeyIndex::npos);
+  for (std::size_t row{}; row != ptrs_.size(); ++row) {
+    if (auto const& ptr = side(ptrs_[row]); ptr.id() == pid) {
+      keys[row] = ptr.key();
+    }
+  }
+  return keys;
+}
+
+template <typename L, typename R>
+inline void
+art::Assns<L, R, void>::clearKeyIndices() noexcept
+{
+  leftKeyIndices_.clear();
+  rightKeyIndices_.clear();
+}
+
+template <typename L, typename R>
+inline void
+art::Assns<L, R, void>::grow_by(size_type const n)
+{
+  if (auto const size = ptrs_.size() + n; size > ptrs_.capacity()) {
+    ptrs_.reserve(std::max(size, 2 * ptrs_.capacity()));
+  }
+}
+
+template <typename L, typename R>
+inline void
+art::Assns<L, R, void>::reserve(size_type const n)
+{
+  ptrs_.reserve(n);
 }
 
 template <typename L, typename R>
@@ -361,6 +571,7 @@ inline void
 art::Assns<L, R, void>::addSingle(Ptr<left_t> const& left,
                                   Ptr<right_t> const& right)
 {
+  clearKeyIndices();
   ptrs_.emplace_back(left, right);
 }
 
@@ -373,8 +584,12 @@ art::Assns<L, R, void>::addMany(Ls const& lefts, Ptr<right_t> const& right)
                 "\n\nart error: The first argument must be a container whose "
                 "value_type is art::Ptr<L>\n"
                 "           corresponding to an Assns<L, R(, D)> object.\n");
+  clearKeyIndices();
+  if constexpr (detail::has_size_member<Ls>::value) {
+    grow_by(lefts.size());
+  }
   for (auto const& left : lefts) {
-    addSingle(left, right);
+    ptrs_.emplace_back(left, right);
   }
 }
 
@@ -387,8 +602,35 @@ art::Assns<L, R, void>::addMany(Ptr<left_t> const& left, Rs const& rights)
                 "\n\nart error: The second argument must be a container whose "
                 "value_type is art::Ptr<R>\n"
                 "           corresponding to an Assns<L, R(, D)> object.\n");
+  clearKeyIndices();
+  if constexpr (detail::has_size_member<Rs>::value) {
+    grow_by(rights.size());
+  }
   for (auto const& right : rights) {
-    addSingle(left, right);
+    ptrs_.emplace_back(left, right);
+  }
+}
+
+template <typename L, typename R>
+template <typename LP, typename LKeys, typename RP, typename RKeys>
+void
+art::Assns<L, R, void>::addMany(LP const& leftProduct,
+                                LKeys const& leftKeys,
+                                RP const& rightProduct,
+                                RKeys const& rightKeys)
+{
+  detail::check_assns_sizes(
+    std::size(leftKeys), std::size(rightKeys), "right keys");
+  auto const [left_id, left_getter] = detail::assns_product(leftProduct);
+  auto const [right_id, right_getter] = detail::assns_product(rightProduct);
+  clearKeyIndices();
+  grow_by(std::size(leftKeys));
+  auto right_key = std::begin(rightKeys);
+  for (auto const left_key : leftKeys) {
+    ptrs_.emplace_back(
+      Ptr<left_t>{left_id, static_cast<std::size_t>(left_key), left_getter},
+      Ptr<right_t>{
+        right_id, static_cast<std::size_t>(*right_key++), right_getter});
   }
 }
 
@@ -412,9 +654,13 @@ inline void
 art::Assns<L, R, void>::swap_(art::Assns<L, R, void>& other)
 {
   using std::swap;
+  clearKeyIndices();
+  other.clearKeyIndices();
   swap(ptrs_, other.ptrs_);
   swap(ptr_data_1_, other.ptr_data_1_);
   swap(ptr_data_2_, other.ptr_data_2_);
+  swap(packed_1_, other.packed_1_);
+  swap(packed_2_, other.packed_2_);
 }
 
 template <typename L, typename R>
@@ -433,8 +679,8 @@ template <typename L, typename R>
 inline bool
 art::Assns<L, R, void>::left_first() const
 {
-  static bool const lf_s = (art::TypeID{typeid(left_t)}.friendlyClassName() <
-                            art::TypeID{typeid(right_t)}.friendlyClassName());
+  static bool const lf_s =
+    static_friendly_name<left_t>() < static_friendly_name<right_t>();
   return lf_s;
 }
 
@@ -442,8 +688,25 @@ template <typename L, typename R>
 void
 art::Assns<L, R, void>::fill_transients()
 {
-  // Precondition: ptr_data_1_.size() = ptr_data_2_.size();
+  // Precondition: ptr_data_1_.size() = ptr_data_2_.size() and
+  // packed_1_.size() == packed_2_.size(), one of them being zero.
+  clearKeyIndices();
   ptrs_.clear();
+  if (!packed_1_.empty()) {
+    ptrs_.reserve(packed_1_.size());
+    auto const& l_ref = left_first() ? packed_1_ : packed_2_;
+    auto const& r_ref = left_first() ? packed_2_ : packed_1_;
+    for (std::size_t i{}, e = l_ref.size(); i != e; ++i) {
+      auto const& l = l_ref.product(i);
+      auto const& r = r_ref.product(i);
+      ptrs_.emplace_back(
+        Ptr<left_t>{l.id(), l_ref.key(i), l.productGetter()},
+        Ptr<right_t>{r.id(), r_ref.key(i), r.productGetter()});
+    }
+    packed_1_.clear();
+    packed_2_.clear();
+    return;
+  }
   ptrs_.reserve(ptr_data_1_.size());
   ptr_data_t const& l_ref = left_first() ? ptr_data_1_ : ptr_data_2_;
   ptr_data_t const& r_ref = left_first() ? ptr_data_2_ : ptr_data_1_;
@@ -464,15 +727,18 @@ template <typename L, typename R>
 void
 art::Assns<L, R, void>::fill_from_transients()
 {
-  if (!ptr_data_1_.empty()) {
-    assert(ptr_data_1_.size() == ptr_data_2_.size() &&
-           ptr_data_2_.size() == ptrs_.size() &&
+  if (!ptr_data_1_.empty() || !packed_1_.empty()) {
+    assert(ptr_data_1_.size() + packed_1_.size() == ptrs_.size() &&
+           ptr_data_2_.size() + packed_2_.size() == ptrs_.size() &&
            "Assns: internal inconsistency between transient and persistent "
            "member data.");
     // Multiple output modules: nothing to do on second and subsequent
     // calls.
     return;
   }
+  if (pack_transients()) {
+    return;
+  }
   ptr_data_t& l_ref = left_first() ? ptr_data_1_ : ptr_data_2_;
   ptr_data_t& r_ref = left_first() ? ptr_data_2_ : ptr_data_1_;
   l_ref.reserve(ptrs_.size());
@@ -483,6 +749,25 @@ art::Assns<L, R, void>::fill_from_transients()
   }
 }
 
+template <typename L, typename R>
+bool
+art::Assns<L, R, void>::pack_transients()
+{
+  auto& l_ref = left_first() ? packed_1_ : packed_2_;
+  auto& r_ref = left_first() ? packed_2_ : packed_1_;
+  l_ref.reserve(ptrs_.size());
+  r_ref.reserve(ptrs_.size());
+  for (auto const& pr : ptrs_) {
+    if (!l_ref.push_back(pr.first.refCore(), pr.first.key()) ||
+        !r_ref.push_back(pr.second.refCore(), pr.second.key())) {
+      l_ref.clear();
+      r_ref.clear();
+      return false;
+    }
+  }
+  return true;
+}
+
 template <typename L, typename R, typename D>
 inline art::Assns<L, R, D>::Assns()
 {
@@ -555,21 +840,73 @@ art::Assns<L, R, D>::addSingle(Ptr<left_t> const& left,
 }
 
 template <typename L, typename R, typename D>
-template <typename Ls, typename Ds>
 inline void
-art::Assns<L, R, D>::addMany(Ls const& lefts,
-                             Ptr<right_t> const& right,
-                             Ds const& data)
+art::Assns<L, R, D>::addSingle(Ptr<left_t> const& left,
+                               Ptr<right_t> const& right,
+                               data_t&& data)
+{
+  base::addSingle(left, right);
+  data_.push_back(std::move(data));
+}
+
+template <typename L, typename R, typename D>
+inline void
+art::Assns<L, R, D>::reserve(size_type const n)
+{
+  base::reserve(n);
+  data_.reserve(n);
+}
+
+template <typename L, typename R, typename D>
+template <typename Ds>
+inline void
+art::Assns<L, R, D>::append_data(Ds const& data)
 {
   static_assert(std::is_same_v<typename Ds::value_type, D>,
                 "\n\nart error: The data argument must be a container whose "
                 "value_type is D corresponding\n"
                 "           to an Assns<L, R, D> object.\n");
-  assert(lefts.size() == data.size());
-  base::addMany(lefts, right);
   data_.insert(data_.end(), data.begin(), data.end());
 }
 
+template <typename L, typename R, typename D>
+inline void
+art::Assns<L, R, D>::append_data(std::vector<data_t>&& data)
+{
+  if (data_.empty() && data_.capacity() <= data.capacity()) {
+    // Take over the buffer.
+    data_.swap(data);
+    return;
+  }
+  data_.insert(data_.end(),
+               std::make_move_iterator(data.begin()),
+               std::make_move_iterator(data.end()));
+}
+
+template <typename L, typename R, typename D>
+template <typename Ls, typename Ds>
+inline void
+art::Assns<L, R, D>::addMany(Ls const& lefts,
+                             Ptr<right_t> const& right,
+                             Ds const& data)
+{
+  detail::check_assns_sizes(lefts.size(), data.size(), "data");
+  base::addMany(lefts, right);
+  append_data(data);
+}
+
+template <typename L, typename R, typename D>
+template <typename Ls>
+inline void
+art::Assns<L, R, D>::addMany(Ls const& lefts,
+                             Ptr<right_t> const& right,
+                             std::vector<data_t>&& data)
+{
+  detail::check_assns_sizes(lefts.size(), data.size(), "data");
+  base::addMany(lefts, right);
+  append_data(std::move(data));
+}
+
 template <typename L, typename R, typename D>
 template <typename Rs, typename Ds>
 void
@@ -577,13 +914,53 @@ art::Assns<L, R, D>::addMany(Ptr<left_t> const& left,
                              Rs const& rights,
                              Ds const& data)
 {
-  static_assert(std::is_same_v<typename Ds::value_type, D>,
-                "\n\nart error: The data argument must be a container whose "
-                "value_type is D corresponding\n"
-                "           to an Assns<L, R, D> object.\n");
-  assert(rights.size() == data.size());
+  detail::check_assns_sizes(rights.size(), data.size(), "data");
   base::addMany(left, rights);
-  data_.insert(data_.end(), data.begin(), data.end());
+  append_data(data);
+}
+
+template <typename L, typename R, typename D>
+template <typename Rs>
+void
+art::Assns<L, R, D>::addMany(Ptr<left_t> const& left,
+                             Rs const& rights,
+                             std::vector<data_t>&& data)
+{
+  detail::check_assns_sizes(rights.size(), data.size(), "data");
+  base::addMany(left, rights);
+  append_data(std::move(data));
+}
+
+template <typename L, typename R, typename D>
+template <typename LP,
+          typename LKeys,
+          typename RP,
+          typename RKeys,
+          typename Ds>
+void
+art::Assns<L, R, D>::addMany(LP const& leftProduct,
+                             LKeys const& leftKeys,
+                             RP const& rightProduct,
+                             RKeys const& rightKeys,
+                             Ds const& data)
+{
+  detail::check_assns_sizes(std::size(leftKeys), std::size(data), "data");
+  base::addMany(leftProduct, leftKeys, rightProduct, rightKeys);
+  append_data(data);
+}
+
+template <typename L, typename R, typename D>
+template <typename LP, typename LKeys, typename RP, typename RKeys>
+void
+art::Assns<L, R, D>::addMany(LP const& leftProduct,
+                             LKeys const& leftKeys,
+                             RP const& rightProduct,
+                             RKeys const& rightKeys,
+                             std::vector<data_t>&& data)
+{
+  detail::check_assns_sizes(std::size(leftKeys), data.size(), "data");
+  base::addMany(leftProduct, leftKeys, rightProduct, rightKeys);
+  append_data(std::move(data));
 }
 
 template <typename L, typename R, typename D>
@@ -12,22 +12,48 @@
  * * `art::for_each_group_with_left()` executing the provided function
  *   on each of the elements associated to the same object, for each
  *   object, while also providing a reference to the object.
+ *
+ * * `art::for_each_group_par()` and `art::for_each_group_with_left_par()`,
+ *   their counterparts calling the function concurrently (using TBB) on
+ *   the groups of consecutive associations with the same left object.
+ *
+ * * `art::for_each_group_indexed_par()` calling a function concurrently
+ *   on all the elements associated to each object, whether or not their
+ *   associations are consecutive, via the left key indices of the Assns.
+ *
+ * * `art::transform_groups()` returning the results of a function,
+ *   called concurrently on each object and its associated elements, in a
+ *   vector indexed by the key of the object.
  */
 
 #ifndef canvas_Persistency_Common_AssnsAlgorithms_h
 #define canvas_Persistency_Common_AssnsAlgorithms_h
 
 #include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/AssnsIndex.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/Exception.h"
+#include "canvas/Utilities/span.h"
 
 // range library
 #include "range/v3/algorithm/for_each.hpp"
 #include "range/v3/view/all.hpp"
 #include "range/v3/view/chunk_by.hpp"
 #include "range/v3/view/map.hpp"
+#include "range/v3/view/subrange.hpp"
 #include "range/v3/view/transform.hpp"
 
+// TBB
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 // C/C++ standard libraries
+#include <algorithm>
+#include <cstddef>
 #include <iterator> // std::next()
+#include <type_traits>
+#include <vector>
 
 namespace art {
   /**
@@ -159,6 +185,200 @@ namespace art {
                        func);
   }
 
+  namespace detail {
+    // The positions in assns of the first association of each group of
+    // consecutive associations with the same left Ptr, followed by
+    // assns.size().
+    template <typename A, typename B, typename D>
+    std::vector<std::size_t>
+    left_group_bounds(art::Assns<A, B, D> const& assns)
+    {
+      std::vector<std::size_t> result{0};
+      auto const n = assns.size();
+      for (std::size_t i{1}; i < n; ++i) {
+        if (assns[i].first != assns[i - 1].first) {
+          result.push_back(i);
+        }
+      }
+      if (n != 0) {
+        result.push_back(n);
+      }
+      return result;
+    }
+
+    // The rows of the associations of each left object (with a non-null
+    // Ptr), from the left key indices of assns.
+    template <typename A, typename B, typename D>
+    std::vector<span<std::size_t const>>
+    left_groups(art::Assns<A, B, D> const& assns)
+    {
+      std::vector<ProductID> pids;
+      for (auto const& assn : assns) {
+        auto const pid = assn.first.id();
+        if (pid.isValid() &&
+            (pids.empty() || pids.back() != pid) &&
+            std::find(pids.cbegin(), pids.cend(), pid) == pids.cend()) {
+          pids.push_back(pid);
+        }
+      }
+      std::vector<span<std::size_t const>> result;
+      for (auto const pid : pids) {
+        assns.leftKeyIndex(pid).for_each_key(
+          [&result](std::size_t, auto const rows) {
+            result.push_back(rows);
+          });
+      }
+      return result;
+    }
+
+    template <typename F>
+    void
+    parallel_for_each_index(std::size_t const n, F const& func)
+    {
+      tbb::parallel_for(tbb::blocked_range<std::size_t>{0, n},
+                        [&func](auto const& range) {
+                          for (auto i = range.begin(); i != range.end(); ++i) {
+                            func(i);
+                          }
+                        });
+    }
+  } // namespace detail
+
+  /**
+   * @brief  Parallel counterpart of `for_each_group_with_left()`
+   * @param assns the association being read
+   * @param func functor to be called on each LHS and associated RHS
+   *
+   * The groups are those of `for_each_group_with_left()`: the
+   * sequences of consecutive associations with the same left object.
+   * `func(left, rights)` is called once for each of them, concurrently
+   * and in no particular order, so it must be safe to call from several
+   * threads at once; it should write its results, if any, to a location
+   * that depends on its arguments.  The function returns when all calls
+   * have completed; an exception thrown by `func` is rethrown.
+   */
+  template <typename A, typename B, typename D, typename F>
+  void
+  for_each_group_with_left_par(art::Assns<A, B, D> const& assns, F func)
+  {
+    auto const bounds = detail::left_group_bounds(assns);
+    auto const n_groups = bounds.empty() ? 0 : bounds.size() - 1;
+    detail::parallel_for_each_index(n_groups, [&](std::size_t const i) {
+      auto const first = assns.begin() + bounds[i];
+      auto const last = assns.begin() + bounds[i + 1];
+      auto const& left = assns[bounds[i]].first;
+      func(left, ::ranges::subrange(first, last) | ::ranges::views::values);
+    });
+  }
+
+  /**
+   * @brief  Parallel counterpart of `for_each_group()`
+   * @param assns the association being read
+   * @param func functor to be called on each associated group
+   *
+   * As `for_each_group_with_left_par()`, `func` being called as
+   * `func(rights)`.
+   */
+  template <typename A, typename B, typename D, typename F>
+  void
+  for_each_group_par(art::Assns<A, B, D> const& assns, F func)
+  {
+    for_each_group_with_left_par(
+      assns, [&func](auto const&, auto rights) { func(rights); });
+  }
+
+  /**
+   * @brief  Calls a functor concurrently on each object and all its
+   *         associated elements
+   * @param assns the association being read
+   * @param func functor to be called as `func(left, rights)`
+   *
+   * Unlike `for_each_group_with_left_par()`, the associations of an
+   * object need not be consecutive: they are grouped through the left
+   * key indices of `assns` (see `Assns::leftKeyIndex()`), which are
+   * built, if need be, once for all users of `assns`.  `func` is called
+   * once for each object with a non-null Ptr: `left` is its
+   * `art::Ptr<A>`, and `rights` a random-access range of the
+   * `art::Ptr<B>` associated with it, in the order of `assns`
+   * (see `AssnsIndex`).  The calls are concurrent, as for
+   * `for_each_group_with_left_par()`.
+   */
+  template <typename A, typename B, typename D, typename F>
+  void
+  for_each_group_indexed_par(art::Assns<A, B, D> const& assns, F func)
+  {
+    using rights_t = typename AssnsIndex<A, B, D>::rights_t;
+    auto const groups = detail::left_groups(assns);
+    detail::parallel_for_each_index(groups.size(), [&](std::size_t const i) {
+      auto const rows = groups[i];
+      func(assns[rows[0]].first, rights_t{rows, {&assns}});
+    });
+  }
+
+  /**
+   * @brief  Returns the results of a functor on each object and its
+   *         associated elements, indexed by the key of the object
+   * @param assns the association being read
+   * @param func functor to be called as `func(left, rights)`
+   * @return a vector whose element `k` is the result for the object of
+   *         key `k`, or a default-constructed value if it has no
+   *         associations
+   *
+   * `func` is called as by `for_each_group_indexed_par()`, concurrently,
+   * so that the associations of an object need not be consecutive.  The
+   * size of the result is one more than the largest key.  All the
+   * non-null left Ptrs of `assns` must refer to the same product: an
+   * `art::Exception` is thrown otherwise.
+   *
+   * Example: the total charge of each track, from an
+   * `art::Assns<recob::Track, recob::Hit>`, in any order.
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+   * auto const totalCharge = art::transform_groups(*assns,
+   *   [](auto const& track, auto hits) {
+   *     double total = 0.;
+   *     for (auto const& hit : hits)
+   *       total += hit->Integral();
+   *     return total;
+   *   });
+   * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+   */
+  template <typename A, typename B, typename D, typename F>
+  auto
+  transform_groups(art::Assns<A, B, D> const& assns, F func)
+  {
+    using rights_t = typename AssnsIndex<A, B, D>::rights_t;
+    using result_t = std::decay_t<
+      std::invoke_result_t<F&, art::Ptr<A> const&, rights_t>>;
+    // The elements of the result are assigned concurrently.
+    static_assert(!std::is_same_v<result_t, bool>,
+                  "\n\nart error: transform_groups cannot return a "
+                  "std::vector<bool>.\n"
+                  "           Please return e.g. a char instead.\n");
+    auto const groups = detail::left_groups(assns);
+    std::vector<result_t> result;
+    if (groups.empty()) {
+      return result;
+    }
+    auto const pid = assns[groups.front()[0]].first.id();
+    std::size_t size{};
+    for (auto const rows : groups) {
+      auto const& left = assns[rows[0]].first;
+      if (left.id() != pid) {
+        throw Exception(errors::LogicError, "transform_groups")
+          << "The left Ptrs of the Assns refer to more than one product ("
+          << pid << " and " << left.id() << ").\n";
+      }
+      size = std::max(size, left.key() + 1);
+    }
+    result.resize(size);
+    detail::parallel_for_each_index(groups.size(), [&](std::size_t const i) {
+      auto const rows = groups[i];
+      auto const& left = assns[rows[0]].first;
+      result[left.key()] = func(left, rights_t{rows, {&assns}});
+    });
+    return result;
+  }
+
 } // namespace art
 
 #endif /* canvas_Persistency_Common_AssnsAlgorithms_h */
@@ -0,0 +1,359 @@
+#ifndef canvas_Persistency_Common_AssnsIndex_h
+#define canvas_Persistency_Common_AssnsIndex_h
+// vim: set sw=2 expandtab :
+////////////////////////////////////////////////////////////////////////
+// AssnsIndex
+//
+// The associations of an Assns<L, R, D> by the items they associate,
+// in both directions.
+//
+// For a Ptr<L> (respectively a Ptr<R>), the index gives the number of
+// associations of the item, their rows in the Assns, the associated
+// Ptr<R> (Ptr<L>) objects and, for a non-void D, the data of the
+// associations.  The rows are a span of a compressed-sparse-row index
+// (see detail/AssnsKeyIndex.h), in the order of the Assns; the
+// associated items and data are random-access ranges over those rows.
+// Each query takes constant time, and the associations need not be
+// sorted or grouped in the Assns.
+//
+// The per-product indices are built on first use and cached in the
+// Assns itself, so that all AssnsIndex objects for an Assns product
+// (e.g. in several modules processing an event) share them.  An
+// AssnsIndex may be used concurrently.  The Assns must outlive it, and
+// must not be modified while it is used.
+//
+// Example: the tracks of the clusters of a hit.
+//
+//   AssnsIndex const hitClusters{hitClusterAssns};
+//   AssnsIndex const clusterTracks{clusterTrackAssns};
+//   for (auto const& cluster : hitClusters.rights(hit)) {
+//     for (auto const& track : clusterTracks.rights(cluster)) {
+//       ...
+//     }
+//   }
+//
+////////////////////////////////////
+// Interface.
+//////////
+//
+//   explicit AssnsIndex(Assns<L, R, D> const& assns);
+//
+//   span<std::size_t const> leftRows(Ptr<L> const&) const;
+//   span<std::size_t const> rightRows(Ptr<R> const&) const;
+//   span<std::size_t const> leftRows(ProductID, std::size_t key) const;
+//   span<std::size_t const> rightRows(ProductID, std::size_t key) const;
+//
+//   std::size_t degreeOfLeft(Ptr<L> const&) const;
+//   std::size_t degreeOfRight(Ptr<R> const&) const;
+//
+//   rights_t rights(Ptr<L> const&) const;    // Range of Ptr<R> const&.
+//   lefts_t lefts(Ptr<R> const&) const;      // Range of Ptr<L> const&.
+//   data_t leftData(Ptr<L> const&) const;    // Range of D const&.
+//   data_t rightData(Ptr<R> const&) const;   // Range of D const&.
+//
+// The functions are named for the side of the item they take, rather
+// than overloaded on Ptr<L> and Ptr<R>, which would be ambiguous for
+// L == R.  (Assns<T, T, D> is not implemented at present.)
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/span.h"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace art {
+
+  template <typename L, typename R, typename D = void>
+  class AssnsIndex;
+
+  namespace detail {
+
+    // Projections of the rows of an Assns onto their parts.
+    template <typename A>
+    struct assns_left {
+      A const* assns;
+      auto const&
+      operator()(std::size_t const row) const
+      {
+        return (*assns)[row].first;
+      }
+    };
+
+    template <typename A>
+    struct assns_right {
+      A const* assns;
+      auto const&
+      operator()(std::size_t const row) const
+      {
+        return (*assns)[row].second;
+      }
+    };
+
+    template <typename A>
+    struct assns_data {
+      A const* assns;
+      auto const&
+      operator()(std::size_t const row) const
+      {
+        return assns->data(row);
+      }
+    };
+
+    // A random-access range of the projections of a span of rows.
+    template <typename Projection>
+    class ProjectedRows {
+    public:
+      using reference =
+        decltype(std::declval<Projection const&>()(std::size_t{}));
+      using value_type = std::remove_cv_t<std::remove_reference_t<reference>>;
+      using size_type = std::size_t;
+
+      class const_iterator {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = ProjectedRows::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type const*;
+        using reference = ProjectedRows::reference;
+
+        const_iterator() = default;
+        const_iterator(std::size_t const* row, Projection proj)
+          : row_{row}, proj_{proj}
+        {}
+
+        reference
+        operator*() const
+        {
+          return proj_(*row_);
+        }
+        pointer
+        operator->() const
+        {
+          return &proj_(*row_);
+        }
+        reference
+        operator[](difference_type const n) const
+        {
+          return proj_(row_[n]);
+        }
+
+        const_iterator&
+        operator++()
+        {
+          ++row_;
+          return *this;
+        }
+        const_iterator
+        operator++(int)
+        {
+          auto result = *this;
+          ++row_;
+          return result;
+        }
+        const_iterator&
+        operator--()
+        {
+          --row_;
+          return *this;
+        }
+        const_iterator
+        operator--(int)
+        {
+          auto result = *this;
+          --row_;
+          return result;
+        }
+        const_iterator&
+        operator+=(difference_type const n)
+        {
+          row_ += n;
+          return *this;
+        }
+        const_iterator&
+        operator-=(difference_type const n)
+        {
+          row_ -= n;
+          return *this;
+        }
+        friend const_iterator
+        operator+(const_iterator it, difference_type const n)
+        {
+          return it += n;
+        }
+        friend const_iterator
+        operator+(difference_type const n, const_iterator it)
+        {
+          return it += n;
+        }
+        friend const_iterator
+        operator-(const_iterator it, difference_type const n)
+        {
+          return it -= n;
+        }
+        friend difference_type
+        operator-(const_iterator const& a, const_iterator const& b)
+        {
+          return a.row_ - b.row_;
+        }
+
+        friend bool
+        operator==(const_iterator const& a, const_iterator const& b)
+        {
+          return a.row_ == b.row_;
+        }
+        friend bool
+        operator!=(const_iterator const& a, const_iterator const& b)
+        {
+          return a.row_ != b.row_;
+        }
+        friend bool
+        operator<(const_iterator const& a, const_iterator const& b)
+        {
+          return a.row_ < b.row_;
+        }
+        friend bool
+        operator>(const_iterator const& a, const_iterator const& b)
+        {
+          return b < a;
+        }
+        friend bool
+        operator<=(const_iterator const& a, const_iterator const& b)
+        {
+          return !(b < a);
+        }
+        friend bool
+        operator>=(const_iterator const& a, const_iterator const& b)
+        {
+          return !(a < b);
+        }
+
+      private:
+        std::size_t const* row_{nullptr};
+        Projection proj_{};
+      };
+      using iterator = const_iterator;
+
+      ProjectedRows(span<std::size_t const> const rows, Projection const proj)
+        : rows_{rows}, proj_{proj}
+      {}
+
+      const_iterator
+      begin() const
+      {
+        return {rows_.begin(), proj_};
+      }
+      const_iterator
+      end() const
+      {
+        return {rows_.end(), proj_};
+      }
+      size_type
+      size() const noexcept
+      {
+        return rows_.size();
+      }
+      bool
+      empty() const noexcept
+      {
+        return rows_.empty();
+      }
+      reference
+      operator[](size_type const i) const
+      {
+        return proj_(rows_[i]);
+      }
+      span<std::size_t const>
+      rows() const noexcept
+      {
+        return rows_;
+      }
+
+    private:
+      span<std::size_t const> rows_;
+      Projection proj_;
+    };
+
+  } // namespace detail
+
+  template <typename L, typename R, typename D>
+  class AssnsIndex {
+  public:
+    using assns_t = Assns<L, R, D>;
+    using lefts_t = detail::ProjectedRows<detail::assns_left<assns_t>>;
+    using rights_t = detail::ProjectedRows<detail::assns_right<assns_t>>;
+    using data_t = detail::ProjectedRows<detail::assns_data<assns_t>>;
+
+    explicit AssnsIndex(assns_t const& assns) noexcept : assns_{&assns} {}
+
+    span<std::size_t const>
+    leftRows(ProductID const pid, std::size_t const key) const
+    {
+      return assns_->leftKeyIndex(pid).rows(key);
+    }
+    span<std::size_t const>
+    rightRows(ProductID const pid, std::size_t const key) const
+    {
+      return assns_->rightKeyIndex(pid).rows(key);
+    }
+
+    span<std::size_t const>
+    leftRows(Ptr<L> const& left) const
+    {
+      return leftRows(left.id(), left.key());
+    }
+    span<std::size_t const>
+    rightRows(Ptr<R> const& right) const
+    {
+      return rightRows(right.id(), right.key());
+    }
+
+    std::size_t
+    degreeOfLeft(Ptr<L> const& left) const
+    {
+      return leftRows(left).size();
+    }
+    std::size_t
+    degreeOfRight(Ptr<R> const& right) const
+    {
+      return rightRows(right).size();
+    }
+
+    rights_t
+    rights(Ptr<L> const& left) const
+    {
+      return {leftRows(left), {assns_}};
+    }
+    lefts_t
+    lefts(Ptr<R> const& right) const
+    {
+      return {rightRows(right), {assns_}};
+    }
+
+    // For a non-void D only.
+    data_t
+    leftData(Ptr<L> const& left) const
+    {
+      return {leftRows(left), {assns_}};
+    }
+    data_t
+    rightData(Ptr<R> const& right) const
+    {
+      return {rightRows(right), {assns_}};
+    }
+
+  private:
+    assns_t const* assns_;
+  };
+
+} // namespace art
+
+#endif /* canvas_Persistency_Common_AssnsIndex_h */
+
+// Local Variables:
+// mode: c++
+// End:
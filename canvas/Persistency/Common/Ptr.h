@@ -47,6 +47,7 @@
 #include "canvas/Persistency/Provenance/ProductID.h"
 #include "canvas/Utilities/Exception.h"
 #include "canvas/Utilities/ensurePointer.h"
+#include "canvas/Utilities/static_type_name.h"
 #include "cetlib_except/demangle.h"
 
 #include <cassert>
@@ -72,6 +73,20 @@ namespace art {
 
   } // namespace detail
 
+  template <typename T>
+  class Ptr;
+
+  template <typename T>
+  struct static_type_name_traits<Ptr<T>>
+    : detail::static_template_name_traits<T> {
+    static std::string
+    name()
+    {
+      return detail::static_template_name_traits<T>::name_of(
+        "art::Ptr");
+    }
+  };
+
   template <typename T>
   class Ptr {
   public:
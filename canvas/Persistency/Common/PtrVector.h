@@ -10,6 +10,7 @@
 
 #include "canvas/Persistency/Common/Ptr.h"
 #include "canvas/Persistency/Common/PtrVectorBase.h"
+#include "canvas/Utilities/static_type_name.h"
 #include "cetlib/container_algorithms.h"
 
 #include <initializer_list>
@@ -20,6 +21,17 @@ namespace art {
   template <typename T>
   class PtrVector;
 
+  template <typename T>
+  struct static_type_name_traits<PtrVector<T>>
+    : detail::static_template_name_traits<T> {
+    static std::string
+    name()
+    {
+      return detail::static_template_name_traits<T>::name_of(
+        "art::PtrVector");
+    }
+  };
+
   template <typename T>
   void swap(PtrVector<T>&, PtrVector<T>&);
 
@@ -18,6 +18,7 @@
 #include "canvas/Persistency/Common/detail/aggregate.h"
 #include "canvas/Persistency/Provenance/SubRunID.h"
 #include "canvas/Utilities/DebugMacros.h"
+#include "canvas/Utilities/static_type_name.h"
 #include "cetlib/metaprogramming.h"
 #include "cetlib_except/demangle.h"
 
@@ -32,6 +33,17 @@ namespace art {
   template <typename T>
   class Wrapper;
 
+  template <typename T>
+  struct static_type_name_traits<Wrapper<T>>
+    : detail::static_template_name_traits<T> {
+    static std::string
+    name()
+    {
+      return detail::static_template_name_traits<T>::name_of(
+        "art::Wrapper");
+    }
+  };
+
   // Implementation detail declarations.
   namespace detail {
 
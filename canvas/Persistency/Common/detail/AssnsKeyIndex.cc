@@ -0,0 +1,105 @@
+#include "canvas/Persistency/Common/detail/AssnsKeyIndex.h"
+// vim: set sw=2 expandtab :
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace {
+  // Keys up to this multiple of the number of rows (plus a constant)
+  // are indexed directly.
+  constexpr std::size_t max_density_ratio{2};
+  constexpr std::size_t min_dense_keys{64};
+}
+
+art::detail::AssnsKeyIndex::AssnsKeyIndex(std::vector<std::size_t> const& keys)
+{
+  std::size_t n_rows{};
+  std::size_t max_key{};
+  for (auto const key : keys) {
+    if (key != npos) {
+      ++n_rows;
+      max_key = std::max(max_key, key);
+    }
+  }
+  if (n_rows == 0) {
+    return;
+  }
+  rows_.resize(n_rows);
+
+  if (max_key < max_density_ratio * n_rows + min_dense_keys) {
+    // Counting sort: offsets_[key + 1] first counts the rows of key.
+    offsets_.assign(max_key + 2, 0);
+    for (auto const key : keys) {
+      if (key != npos) {
+        ++offsets_[key + 1];
+      }
+    }
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+    auto next = offsets_;
+    for (std::size_t row{}; row != keys.size(); ++row) {
+      if (auto const key = keys[row]; key != npos) {
+        rows_[next[key]++] = row;
+      }
+    }
+    return;
+  }
+
+  std::vector<std::pair<std::size_t, std::size_t>> key_rows;
+  key_rows.reserve(n_rows);
+  for (std::size_t row{}; row != keys.size(); ++row) {
+    if (keys[row] != npos) {
+      key_rows.emplace_back(keys[row], row);
+    }
+  }
+  std::sort(key_rows.begin(), key_rows.end());
+  for (std::size_t i{}; i != key_rows.size(); ++i) {
+    auto const [key, row] = key_rows[i];
+    if (keys_.empty() || keys_.back() != key) {
+      keys_.push_back(key);
+      offsets_.push_back(i);
+    }
+    rows_[i] = row;
+  }
+  offsets_.push_back(n_rows);
+}
+
+art::span<std::size_t const>
+art::detail::AssnsKeyIndex::rows(std::size_t const key) const noexcept
+{
+  std::size_t i{key};
+  if (!keys_.empty()) {
+    auto const it = std::lower_bound(keys_.cbegin(), keys_.cend(), key);
+    if (it == keys_.cend() || *it != key) {
+      return {};
+    }
+    i = it - keys_.cbegin();
+  } else if (offsets_.empty() || key >= offsets_.size() - 1) {
+    return {};
+  }
+  return {rows_.data() + offsets_[i], rows_.data() + offsets_[i + 1]};
+}
+
+art::detail::AssnsKeyIndexCache::Node const*
+art::detail::AssnsKeyIndexCache::find(ProductID const pid) const noexcept
+{
+  for (auto node = head_.load(std::memory_order_acquire); node != nullptr;
+       node = node->next) {
+    if (node->pid == pid) {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+void
+art::detail::AssnsKeyIndexCache::clear() noexcept
+{
+  if (head_.load(std::memory_order_relaxed) == nullptr) {
+    return;
+  }
+  auto node = head_.exchange(nullptr);
+  while (node != nullptr) {
+    delete std::exchange(node, node->next);
+  }
+}
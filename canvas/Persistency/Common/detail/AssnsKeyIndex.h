@@ -0,0 +1,155 @@
+#ifndef canvas_Persistency_Common_detail_AssnsKeyIndex_h
+#define canvas_Persistency_Common_detail_AssnsKeyIndex_h
+// vim: set sw=2 expandtab :
+
+////////////////////////////////////////////////////////////////////////
+//
+// AssnsKeyIndex: the positions ("rows") in an Assns of the associations
+// whose Ptrs on one side refer to a given product, grouped by the keys
+// of those Ptrs, in compressed-sparse-row form: the rows of all keys
+// are stored in one array, in ascending order of key and, for each
+// key, in the order of the Assns, and an array of offsets delimits the
+// rows of each key.
+//
+// When the keys are dense (as are the indices into a vector), the
+// offsets are indexed by key; otherwise, the distinct keys are stored,
+// in ascending order, alongside the offsets, and are binary-searched.
+//
+// AssnsKeyIndexCache holds the indices of an Assns, one per product,
+// built on first use.  Its member functions may be called
+// concurrently, except for clear(), which is called only while the
+// Assns is modified.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/span.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace art::detail {
+
+  class AssnsKeyIndex {
+  public:
+    // The key of the rows not to be indexed.
+    static constexpr std::size_t npos = -1;
+
+    AssnsKeyIndex() = default;
+    // keys[row] is the key of row, or npos.
+    explicit AssnsKeyIndex(std::vector<std::size_t> const& keys);
+
+    span<std::size_t const> rows(std::size_t key) const noexcept;
+
+    std::size_t
+    degree(std::size_t const key) const noexcept
+    {
+      return rows(key).size();
+    }
+
+    // The number of rows indexed.
+    std::size_t
+    size() const noexcept
+    {
+      return rows_.size();
+    }
+
+    // All rows indexed, in the order described above: the rows of a
+    // key are a subspan.
+    span<std::size_t const>
+    rows() const noexcept
+    {
+      return {rows_.data(), rows_.size()};
+    }
+
+    // Calls f(key, rows(key)) for each key with rows, in ascending
+    // order of key.
+    template <typename F>
+    void for_each_key(F f) const;
+
+  private:
+    // Empty if the offsets are indexed by key.
+    std::vector<std::size_t> keys_{};
+    std::vector<std::size_t> offsets_{};
+    std::vector<std::size_t> rows_{};
+  };
+
+  class AssnsKeyIndexCache {
+  public:
+    AssnsKeyIndexCache() = default;
+    ~AssnsKeyIndexCache() { clear(); }
+
+    // The indices describe the Assns they belong to: a copy starts
+    // empty.
+    AssnsKeyIndexCache(AssnsKeyIndexCache const&) noexcept {}
+    AssnsKeyIndexCache&
+    operator=(AssnsKeyIndexCache const&) noexcept
+    {
+      clear();
+      return *this;
+    }
+
+    // The index of product pid, built from the keys returned by
+    // make_keys() (see above) if not already cached.  Finding a cached
+    // index takes no lock.
+    template <typename F>
+    AssnsKeyIndex const& get(ProductID pid, F make_keys) const;
+
+    void clear() noexcept;
+
+  private:
+    struct Node {
+      ProductID pid;
+      AssnsKeyIndex index;
+      Node const* next;
+    };
+
+    Node const* find(ProductID pid) const noexcept;
+
+    // Nodes are only ever prepended, until cleared.
+    mutable std::atomic<Node const*> head_{nullptr};
+    mutable std::mutex mutex_{};
+  };
+
+} // namespace art::detail
+
+template <typename F>
+void
+art::detail::AssnsKeyIndex::for_each_key(F f) const
+{
+  auto const n_keys = keys_.empty() ? offsets_.size() - !offsets_.empty() :
+                                      keys_.size();
+  for (std::size_t i{}; i != n_keys; ++i) {
+    auto const begin = offsets_[i];
+    auto const end = offsets_[i + 1];
+    if (begin != end) {
+      f(keys_.empty() ? i : keys_[i],
+        span<std::size_t const>{rows_.data() + begin, rows_.data() + end});
+    }
+  }
+}
+
+template <typename F>
+art::detail::AssnsKeyIndex const&
+art::detail::AssnsKeyIndexCache::get(ProductID const pid, F make_keys) const
+{
+  if (auto const node = find(pid)) {
+    return node->index;
+  }
+  std::lock_guard lock{mutex_};
+  if (auto const node = find(pid)) {
+    return node->index;
+  }
+  auto const node = new Node{
+    pid, AssnsKeyIndex{make_keys()}, head_.load(std::memory_order_relaxed)};
+  head_.store(node, std::memory_order_release);
+  return node->index;
+}
+
+#endif /* canvas_Persistency_Common_detail_AssnsKeyIndex_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -6,6 +6,8 @@
 
 #include "canvas/Persistency/Common/Assns.h"
 #include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/detail/AssnsKeyIndex.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
 #include "canvas/Persistency/Provenance/ProductToken.h"
 #include "canvas/Utilities/Exception.h"
 #include "canvas/Utilities/InputTag.h"
@@ -13,6 +15,7 @@
 
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace art::detail {
 
@@ -42,6 +45,22 @@ namespace art::detail {
 
   class IPRHelperDef {};
 
+  template <typename T>
+  struct is_std_vector : std::false_type {};
+  template <typename T>
+  struct is_std_vector<std::vector<T>> : std::true_type {};
+
+  // Reserves room for n items associated with the A object of the
+  // given index, for one-to-many queries only.
+  template <typename Coll>
+  void
+  reserve_one_to_many(size_t const index, size_t const n, Coll& coll)
+  {
+    if constexpr (is_std_vector<typename Coll::value_type>::value) {
+      coll[index].reserve(n);
+    }
+  }
+
   template <typename ProdA,
             typename ProdB,
             typename Data,
@@ -69,6 +88,16 @@ namespace art::detail {
     void init(size_t, IPRHelperDef&) const;
     template <typename ASSNS>
     void fill(ptrdiff_t, ASSNS const&, size_t, IPRHelperDef&) const;
+
+    template <typename DataColl>
+    void
+    reserve(size_t const data_index, size_t const n, DataColl& data) const
+    {
+      reserve_one_to_many(data_index, n, data);
+    }
+    void
+    reserve(size_t, size_t, IPRHelperDef&) const
+    {}
   };
 
   // Note that the template parameter Bcoll is determined by the
@@ -95,6 +124,13 @@ namespace art::detail {
     template <typename Bcoll>
     void init(size_t size, std::vector<Bcoll>& bColls) const;
 
+    template <typename Bcoll>
+    void
+    reserve(size_t const index, size_t const n, Bcoll& bColl) const
+    {
+      reserve_one_to_many(index, n, bColl);
+    }
+
     // 3. When Bcoll is a collection of pointer to const B -- one to many.
     template <typename Bcoll>
     std::enable_if_t<std::is_same_v<typename Bcoll::value_type, ProdB const*>>
@@ -148,7 +184,39 @@ public:
                                 Bcoll& bColl,
                                 dataColl_t& dColl) const;
 
+  // 3. As 1. and 2., where aColl is the product aID.
+  template <typename Acoll, typename Bcoll>
+  shared_exception_t operator()(Acoll const& aColl,
+                                ProductID aID,
+                                Bcoll& bColl) const;
+  template <typename Acoll, typename Bcoll>
+  shared_exception_t operator()(Acoll const& aColl,
+                                ProductID aID,
+                                Bcoll& bColl,
+                                dataColl_t& dColl) const;
+
 private:
+  using assns_t = Assns<ProdA, ProdB, Data>;
+
+  template <typename Acoll, typename Bcoll>
+  shared_exception_t fill(Acoll const& aColl,
+                          ProductID aID,
+                          Bcoll& bColl,
+                          dataColl_t& dColl) const;
+
+  template <typename Acoll, typename Bcoll>
+  void fillByKey(assns_t const& assns,
+                 Acoll const& aColl,
+                 ProductID aID,
+                 Bcoll& bColl,
+                 dataColl_t& dColl) const;
+
+  template <typename Acoll, typename Bcoll>
+  void fillByAddress(assns_t const& assns,
+                     Acoll const& aColl,
+                     Bcoll& bColl,
+                     dataColl_t& dColl) const;
+
   EVENT const& event_;
   InputTag const assnsTag_;
 };
@@ -170,31 +238,112 @@ art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::operator()(
 }
 
 // 2.
+template <typename ProdA,
+          typename ProdB,
+          typename Data,
+          typename DATACOLL,
+          typename EVENT>
+template <typename Acoll, typename Bcoll>
+inline auto
+art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::operator()(
+  Acoll const& aColl,
+  Bcoll& bColl,
+  dataColl_t& dColl) const -> shared_exception_t
+{
+  return fill(aColl, ProductID::invalid(), bColl, dColl);
+}
+
+// 3.
+template <typename ProdA,
+          typename ProdB,
+          typename Data,
+          typename DATACOLL,
+          typename EVENT>
+template <typename Acoll, typename Bcoll>
+inline auto
+art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::operator()(
+  Acoll const& aColl,
+  ProductID const aID,
+  Bcoll& bColl) const -> shared_exception_t
+{
+  IPRHelperDef dummy;
+  return fill(aColl, aID, bColl, dummy);
+}
+
+template <typename ProdA,
+          typename ProdB,
+          typename Data,
+          typename DATACOLL,
+          typename EVENT>
+template <typename Acoll, typename Bcoll>
+inline auto
+art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::operator()(
+  Acoll const& aColl,
+  ProductID const aID,
+  Bcoll& bColl,
+  dataColl_t& dColl) const -> shared_exception_t
+{
+  return fill(aColl, aID, bColl, dColl);
+}
+
 ////////////////////////////////////////////////////////////////////////
 // Implementation notes.
 //
-// The current implementation does not verify that the ProductID of the
-// item in the association collection matches that of the item in the
-// reference collection before attempting to dereference its Ptr
-// (although it does verify ptr.isAvailable()). This means that in the
-// case where an association collection refers to multiple available
-// AProd collections, all of those collections will be read from file
-// even if the reference collection does not include items from one or
-// more of those AProd collections.
-//
-// If one were to provide an implementation that did this, one would
-// change the unordered_multimap to key on the full ptr instead of the
-// pointer. There is a specialization of std::hash<T> for T =
-// art::Ptr<X> to support this.
+// When the A objects are known to be the elements of one product --
+// a vector product supplied by handle, or a sequence of Ptrs that all
+// refer to the same product -- the associations are looked up by the
+// key of their A Ptrs, without dereferencing those Ptrs, in the
+// Assns's cached AssnsKeyIndex for that product (see
+// AssnsKeyIndex.h).  The index is built once per Assns product and
+// shared by all queries of it, and gives the associated items of each
+// A object in the order of the Assns.
 //
-// However, it would be problematic to do the lookup if the reference
-// item was not in fact a Ptr. Maybe it would be relatively efficient if
-// one were able to do a lookup in the table against an entity not a Ptr
-// for which I could write a comparison function that compared the
-// ProductID and only if they matched, the pointer with suitable get().
-//
-// For now however, no-one has requested this,
+// Otherwise (e.g. for a View, or Ptrs to several products), a table of
+// the associations keyed by the address of their available A objects
+// is built for the query.  In the case where an association collection
+// refers to multiple available AProd collections, all of those
+// collections will then be read from file even if the reference
+// collection does not include items from one or more of those AProd
+// collections.
 ////////////////////////////////////////////////////////////////////////
+namespace art::detail {
+  // Whether the A objects may be identified by the keys of their Ptrs.
+  template <typename Acoll, typename ProdA>
+  constexpr bool has_ptr_keys_v =
+    std::is_same_v<Acoll, std::vector<ProdA>> ||
+    std::is_same_v<typename Acoll::value_type, Ptr<ProdA>>;
+
+  // The ID of the product of all A objects, if there is one.
+  template <typename Acoll, typename ProdA>
+  ProductID
+  common_product_id(Acoll const& aColl, ProductID const aID)
+  {
+    if constexpr (std::is_same_v<Acoll, std::vector<ProdA>>) {
+      return aID;
+    } else {
+      ProductID result;
+      for (auto const& ptr : aColl) {
+        if (ptr.isNull() || (result.isValid() && ptr.id() != result)) {
+          return ProductID::invalid();
+        }
+        result = ptr.id();
+      }
+      return result;
+    }
+  }
+
+  template <typename Acoll, typename ProdA, typename It>
+  std::size_t
+  ptr_key(It const it, std::size_t const index)
+  {
+    if constexpr (std::is_same_v<Acoll, std::vector<ProdA>>) {
+      return index;
+    } else {
+      return it->key();
+    }
+  }
+}
+
 template <typename ProdA,
           typename ProdB,
           typename Data,
@@ -202,18 +351,79 @@ template <typename ProdA,
           typename EVENT>
 template <typename Acoll, typename Bcoll>
 auto
-art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::operator()(
+art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::fill(
   Acoll const& aColl,
+  ProductID const aID,
   Bcoll& bColl,
   dataColl_t& dColl) const -> shared_exception_t
 {
-  detail::BcollHelper<ProdB> bh(assnsTag_);
-  detail::DataCollHelper<Data> dh;
-  typename EVENT::template HandleT<Assns<ProdA, ProdB, Data>> assnsHandle;
+  typename EVENT::template HandleT<assns_t> assnsHandle;
   event_.getByLabel(assnsTag_, assnsHandle);
   if (!assnsHandle.isValid()) {
     return assnsHandle.whyFailed(); // Failed to get Assns product.
   }
+  if constexpr (has_ptr_keys_v<Acoll, ProdA>) {
+    if (auto const id = common_product_id<Acoll, ProdA>(aColl, aID);
+        id.isValid()) {
+      fillByKey(*assnsHandle, aColl, id, bColl, dColl);
+      return shared_exception_t();
+    }
+  }
+  fillByAddress(*assnsHandle, aColl, bColl, dColl);
+  return shared_exception_t();
+}
+
+template <typename ProdA,
+          typename ProdB,
+          typename Data,
+          typename DATACOLL,
+          typename EVENT>
+template <typename Acoll, typename Bcoll>
+void
+art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::fillByKey(
+  assns_t const& assns,
+  Acoll const& aColl,
+  ProductID const aID,
+  Bcoll& bColl,
+  dataColl_t& dColl) const
+{
+  detail::BcollHelper<ProdB> bh(assnsTag_);
+  detail::DataCollHelper<Data> dh;
+  bh.init(aColl.size(), bColl);
+  dh.init(aColl.size(), dColl);
+  auto const& index = assns.leftKeyIndex(aID);
+  size_t bIndex{0};
+  using std::cbegin;
+  using std::cend;
+  for (auto i = cbegin(aColl), e = cend(aColl); i != e; ++i, ++bIndex) {
+    auto const rows = index.rows(ptr_key<Acoll, ProdA>(i, bIndex));
+    if (rows.empty()) {
+      continue;
+    }
+    bh.reserve(bIndex, rows.size(), bColl);
+    dh.reserve(bIndex, rows.size(), dColl);
+    for (auto const row : rows) {
+      bh.fill(bIndex, assns[row].second, bColl);
+      dh.fill(row, assns, bIndex, dColl);
+    }
+  }
+}
+
+template <typename ProdA,
+          typename ProdB,
+          typename Data,
+          typename DATACOLL,
+          typename EVENT>
+template <typename Acoll, typename Bcoll>
+void
+art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::fillByAddress(
+  assns_t const& assns,
+  Acoll const& aColl,
+  Bcoll& bColl,
+  dataColl_t& dColl) const
+{
+  detail::BcollHelper<ProdB> bh(assnsTag_);
+  detail::DataCollHelper<Data> dh;
   bh.init(aColl.size(), bColl);
   dh.init(aColl.size(), dColl);
   // Answer cache.
@@ -221,7 +431,7 @@ art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::operator()(
                           std::pair<Ptr<ProdB>, ptrdiff_t>>
     lookupCache;
   ptrdiff_t counter{0};
-  for (auto const& apair : *assnsHandle) {
+  for (auto const& apair : assns) {
     if (apair.first.isAvailable()) {
       lookupCache.emplace(
         apair.first.get(),
@@ -240,13 +450,12 @@ art::detail::IPRHelper<ProdA, ProdB, Data, DATACOLL, EVENT>::operator()(
       std::for_each(
         foundItems.first,
         foundItems.second,
-        [&bh, &dh, &bColl, bIndex, &assnsHandle, &dColl](auto const& itemPair) {
+        [&bh, &dh, &bColl, bIndex, &assns, &dColl](auto const& itemPair) {
           bh.fill(bIndex, itemPair.second.first, bColl);
-          dh.fill(itemPair.second.second, *assnsHandle, bIndex, dColl);
+          dh.fill(itemPair.second.second, assns, bIndex, dColl);
         });
     }
   }
-  return shared_exception_t();
 }
 
 template <typename DATA>
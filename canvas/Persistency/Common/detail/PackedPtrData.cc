@@ -0,0 +1,54 @@
+#include "canvas/Persistency/Common/detail/PackedPtrData.h"
+// vim: set sw=2 expandtab :
+
+#include <algorithm>
+#include <utility>
+
+void
+art::detail::PackedPtrData::reserve(std::size_t const n)
+{
+  keys_.reserve(n);
+}
+
+bool
+art::detail::PackedPtrData::push_back_slow(RefCore const& product,
+                                           key_type const key)
+{
+  auto const it = std::find_if(
+    products_.cbegin(), products_.cend(), [&product](RefCore const& p) {
+      return p.id() == product.id();
+    });
+  std::size_t const slot = it - products_.cbegin();
+  if (slot > std::numeric_limits<slot_type>::max()) {
+    return false;
+  }
+  if (it == products_.cend()) {
+    products_.push_back(product);
+  }
+  if (slots_.empty() && slot != 0) {
+    // The first Ptr of a second product.
+    slots_.reserve(keys_.capacity());
+    slots_.assign(keys_.size(), 0);
+  }
+  keys_.push_back(key);
+  if (!slots_.empty()) {
+    slots_.push_back(static_cast<slot_type>(slot));
+  }
+  return true;
+}
+
+void
+art::detail::PackedPtrData::clear() noexcept
+{
+  PackedPtrData empty;
+  swap(empty);
+}
+
+void
+art::detail::PackedPtrData::swap(PackedPtrData& other) noexcept
+{
+  using std::swap;
+  swap(products_, other.products_);
+  swap(keys_, other.keys_);
+  swap(slots_, other.slots_);
+}
@@ -0,0 +1,120 @@
+#ifndef canvas_Persistency_Common_detail_PackedPtrData_h
+#define canvas_Persistency_Common_detail_PackedPtrData_h
+// vim: set sw=2 expandtab :
+
+////////////////////////////////////////////////////////////////////////
+//
+// PackedPtrData: the Ptrs of one side of an Assns, as persisted from
+// Assns Class_Version 12 onwards.
+//
+// The distinct products referred to are stored once, in order of first
+// use; each Ptr is stored as its key, in 32 bits, and the position
+// ("slot") of its product in that list, in 16 bits.  While all the
+// Ptrs refer to the one product, as is usual, no slots are stored.
+// The products are stored as RefCore objects so that, on read, the
+// RefCoreStreamer sets their product getters.
+//
+// Ptrs whose keys do not fit in 32 bits, or that refer to more than
+// 65536 products, cannot be packed: push_back() then returns false,
+// and the Assns falls back to its previous persistent representation.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "canvas/Persistency/Common/RefCore.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace art::detail {
+
+  class PackedPtrData {
+  public:
+    using key_type = std::uint32_t;
+    using slot_type = std::uint16_t;
+
+    void reserve(std::size_t n);
+
+    // Appends the Ptr of the given product and key, unless it cannot be
+    // packed (see above).
+    bool push_back(RefCore const& product, std::size_t key);
+
+    std::size_t
+    size() const noexcept
+    {
+      return keys_.size();
+    }
+    bool
+    empty() const noexcept
+    {
+      return keys_.empty();
+    }
+
+    RefCore const&
+    product(std::size_t const i) const noexcept
+    {
+      return products_[slots_.empty() ? 0 : slots_[i]];
+    }
+    std::size_t
+    key(std::size_t const i) const noexcept
+    {
+      auto const key = keys_[i];
+      return key == null_key ? std::size_t(-1) : key;
+    }
+
+    // Releases the memory held.
+    void clear() noexcept;
+    void swap(PackedPtrData& other) noexcept;
+
+  private:
+    // The packed form of the key of a null Ptr.
+    static constexpr key_type null_key{
+      std::numeric_limits<key_type>::max()};
+
+    slot_type current_slot() const noexcept;
+    bool push_back_slow(RefCore const& product, key_type key);
+
+    std::vector<RefCore> products_{};
+    std::vector<key_type> keys_{};
+    // Empty while products_ has at most one element.
+    std::vector<slot_type> slots_{};
+  };
+
+  inline bool
+  PackedPtrData::push_back(RefCore const& product, std::size_t const key)
+  {
+    if (key >= null_key && key != std::size_t(-1)) {
+      return false;
+    }
+    auto const packed_key = static_cast<key_type>(key);
+    if (products_.empty() ||
+        products_[current_slot()].id() != product.id()) {
+      return push_back_slow(product, packed_key);
+    }
+    keys_.push_back(packed_key);
+    if (!slots_.empty()) {
+      slots_.push_back(slots_.back());
+    }
+    return true;
+  }
+
+  inline PackedPtrData::slot_type
+  PackedPtrData::current_slot() const noexcept
+  {
+    return slots_.empty() ? 0 : slots_.back();
+  }
+
+  inline void
+  swap(PackedPtrData& a, PackedPtrData& b) noexcept
+  {
+    a.swap(b);
+  }
+
+} // namespace art::detail
+
+#endif /* canvas_Persistency_Common_detail_PackedPtrData_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -4,11 +4,16 @@
 #include "canvas/Utilities/Exception.h"
 #include "cetlib_except/demangle.h"
 
+#include "tbb/concurrent_unordered_map.h"
+
 #include <cxxabi.h>
 
+#include <cstddef>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <typeinfo>
+#include <utility>
 
 using namespace art;
 using namespace std;
@@ -153,6 +158,72 @@ namespace {
     // Was a leaf class.
   }
 
+  enum class upcast_status {
+    trivial,
+    not_a_class,
+    found,
+    not_found,
+    ambiguous
+  };
+
+  struct upcast_info {
+    upcast_status status;
+    long offset;
+  };
+
+  upcast_info
+  computeUpcast(type_info const& tid_from, type_info const& tid_to)
+  {
+    auto ci_from = dynamic_cast<abi::__class_type_info const*>(&tid_from);
+    auto ci_to = dynamic_cast<abi::__class_type_info const*>(&tid_to);
+    if (ci_from == nullptr || ci_to == nullptr) {
+      // Not a class, done.
+      return {upcast_status::not_a_class, 0L};
+    }
+    if (ci_from == ci_to) {
+      // Trivial, same types, nothing to do.
+      return {upcast_status::trivial, 0L};
+    }
+    upcast_result res;
+    visit_class_for_upcast(ci_from, ci_to, 0L, res);
+    if (!res.found) {
+      return {upcast_status::not_found, 0L};
+    }
+    if (res.is_ambiguous) {
+      return {upcast_status::ambiguous, 0L};
+    }
+    return {upcast_status::found, res.offset};
+  }
+
+  using type_pair_t = std::pair<type_info const*, type_info const*>;
+
+  struct type_pair_hash {
+    size_t
+    operator()(type_pair_t const& types) const noexcept
+    {
+      hash<type_info const*> const h;
+      return h(types.first) ^ (h(types.second) << 1);
+    }
+  };
+
+  // The hierarchy of a class is walked once for each pair of types; the
+  // type_info objects of a type need not be unique, in which case the
+  // same result may be cached more than once.
+  upcast_info const&
+  cachedUpcast(type_info const& tid_from, type_info const& tid_to)
+  {
+    static tbb::concurrent_unordered_map<type_pair_t,
+                                         upcast_info,
+                                         type_pair_hash>
+      upcasts;
+    type_pair_t const key{&tid_from, &tid_to};
+    if (auto const it = upcasts.find(key); it != upcasts.cend()) {
+      return it->second;
+    }
+    return upcasts.emplace(key, computeUpcast(tid_from, tid_to))
+      .first->second;
+  }
+
 } // unnamed namespace
 
 bool
@@ -162,63 +233,44 @@ detail::upcastAllowed(type_info const& tid_from, type_info const& tid_to)
     // Trivial, nothing to do.
     return true;
   }
-  auto ci_from = dynamic_cast<abi::__class_type_info const*>(&tid_from);
-  auto ci_to = dynamic_cast<abi::__class_type_info const*>(&tid_to);
-  if (ci_from == nullptr) {
-    // Not a class, done.
-    return false;
-  }
-  if (ci_to == nullptr) {
-    // Not a class, done.
-    return false;
-  }
-  if (ci_from == ci_to) {
-    // Trivial, same types, nothing to do.
-    return true;
-  }
-  upcast_result res;
-  visit_class_for_upcast(ci_from, ci_to, 0L, res);
-  return res.found && !res.is_ambiguous;
+  auto const status = cachedUpcast(tid_from, tid_to).status;
+  return status == upcast_status::trivial || status == upcast_status::found;
 }
 
-void const*
-detail::maybeCastObj(void const* ptr,
-                     type_info const& tid_from,
-                     type_info const& tid_to)
+ptrdiff_t
+detail::upcastOffset(type_info const& tid_from, type_info const& tid_to)
 {
   if (tid_from == tid_to) {
     // Trivial, nothing to do.
-    return ptr;
-  }
-  auto ci_from = dynamic_cast<abi::__class_type_info const*>(&tid_from);
-  auto ci_to = dynamic_cast<abi::__class_type_info const*>(&tid_to);
-  if (ci_from == nullptr) {
-    // Not a class, done.
-    return ptr;
-  }
-  if (ci_to == nullptr) {
-    // Not a class, done.
-    return ptr;
+    return 0;
   }
-  if (ci_from == ci_to) {
-    // Trivial, same types, nothing to do.
-    return ptr;
-  }
-  upcast_result res;
-  visit_class_for_upcast(ci_from, ci_to, 0L, res);
-  if (!res.found) {
+  auto const& info = cachedUpcast(tid_from, tid_to);
+  switch (info.status) {
+  case upcast_status::not_found:
     throw Exception(errors::TypeConversion)
       << "maybeCastObj : unable to convert type: "
       << cet::demangle_symbol(tid_from.name())
       << "\nto: " << cet::demangle_symbol(tid_to.name()) << "\n"
       << "No suitable base found.\n";
-  }
-  if (res.is_ambiguous) {
+  case upcast_status::ambiguous:
     throw Exception(errors::TypeConversion)
       << "MaybeCastObj : unable to convert type: "
       << cet::demangle_symbol(tid_from.name())
       << "\nto: " << cet::demangle_symbol(tid_to.name()) << "\n"
       << "Base class is ambiguous.\n";
+  default:
+    return info.offset;
+  }
+}
+
+void const*
+detail::maybeCastObj(void const* ptr,
+                     type_info const& tid_from,
+                     type_info const& tid_to)
+{
+  if (tid_from == tid_to) {
+    // Trivial, nothing to do.
+    return ptr;
   }
-  return static_cast<char const*>(ptr) + res.offset;
+  return applyUpcastOffset(ptr, upcastOffset(tid_from, tid_to));
 }
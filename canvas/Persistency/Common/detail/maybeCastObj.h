@@ -1,10 +1,20 @@
 #ifndef canvas_Persistency_Common_detail_maybeCastObj_h
 #define canvas_Persistency_Common_detail_maybeCastObj_h
 
+#include <cstddef>
 #include <typeinfo>
 
 namespace art::detail {
   bool upcastAllowed(std::type_info const& tiFrom, std::type_info const& tiTo);
+
+  // The offset to be added to the address of an object of type tiFrom
+  // to obtain that of its base class tiTo, or zero if the types are the
+  // same or are not both classes.  The offset is computed once for
+  // each pair of types.  Throws if tiTo is not a unique base of tiFrom.
+  std::ptrdiff_t upcastOffset(std::type_info const& tiFrom,
+                              std::type_info const& tiTo);
+  void const* applyUpcastOffset(void const* address, std::ptrdiff_t offset);
+
   void const* maybeCastObj(void const* address,
                            std::type_info const& tiFrom,
                            std::type_info const& tiTo);
@@ -22,6 +32,14 @@ art::detail::maybeCastObj(element_type const* address,
   return maybeCastObj(address, tiFrom, tiTo);
 }
 
+inline void const*
+art::detail::applyUpcastOffset(void const* const address,
+                               std::ptrdiff_t const offset)
+{
+  return address == nullptr ? nullptr :
+                              static_cast<char const*>(address) + offset;
+}
+
 #endif /* canvas_Persistency_Common_detail_maybeCastObj_h */
 
 // Local Variables:
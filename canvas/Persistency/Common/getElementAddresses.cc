@@ -0,0 +1,59 @@
+#include "canvas/Persistency/Common/getElementAddresses.h"
+// vim: set sw=2 expandtab :
+
+#include "canvas/Utilities/uniform_type_name.h"
+#include "cetlib_except/demangle.h"
+
+#include "tbb/concurrent_unordered_map.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+
+namespace {
+
+  using type_pair_t = std::pair<std::type_info const*, std::type_info const*>;
+
+  // The type_info objects of a type need not be unique, so that the
+  // same decision may be cached more than once; that is harmless.
+  struct type_pair_hash {
+    std::size_t
+    operator()(type_pair_t const& types) const noexcept
+    {
+      std::hash<std::type_info const*> const hash;
+      return hash(types.first) ^ (hash(types.second) << 1);
+    }
+  };
+
+  bool
+  wantsValueType(std::type_info const& mapped_type,
+                 std::type_info const& wanted_type)
+  {
+    art::detail::value_type_helper vh;
+    std::string const mapped_name{
+      cet::demangle_symbol(mapped_type.name())};
+    std::size_t pos{};
+    while (vh.starts_with_pair(mapped_name, pos)) {
+      pos += vh.pair_stem_offset();
+    }
+    std::string const wanted_name{
+      art::uniform_type_name(cet::demangle_symbol(wanted_type.name()))};
+    return pos < wanted_name.size() && vh.starts_with_pair(wanted_name, pos);
+  }
+
+} // unnamed namespace
+
+bool
+art::detail::wantsMapVectorValueType(std::type_info const& mapped_type,
+                                     std::type_info const& wanted_type)
+{
+  static tbb::concurrent_unordered_map<type_pair_t, bool, type_pair_hash>
+    decisions;
+  type_pair_t const key{&mapped_type, &wanted_type};
+  if (auto const it = decisions.find(key); it != decisions.cend()) {
+    return it->second;
+  }
+  return decisions.emplace(key, wantsValueType(mapped_type, wanted_type))
+    .first->second;
+}
@@ -4,8 +4,11 @@
 #include "canvas/Persistency/Common/GetProduct.h"
 #include "canvas/Persistency/Common/detail/maybeCastObj.h"
 #include "canvas/Utilities/uniform_type_name.h"
+#include "cetlib/map_vector.h"
+#include "cetlib_except/demangle.h"
 
 #include <string>
+#include <type_traits>
 #include <typeinfo>
 #include <vector>
 
@@ -24,6 +27,13 @@ namespace art {
 
   namespace detail {
     class value_type_helper;
+
+    // Whether wanted_type is the value_type of a cet::map_vector whose
+    // mapped_type is mapped_type, rather than its mapped_type.  The
+    // decision requires the types' names, and is made once for each
+    // pair of types.
+    bool wantsMapVectorValueType(std::type_info const& mapped_type,
+                                 std::type_info const& wanted_type);
   }
 }
 
@@ -70,12 +80,19 @@ art::getElementAddresses(Collection const& coll,
                          std::vector<unsigned long> const& indices,
                          std::vector<void const*>& oPtr)
 {
-  oPtr.reserve(indices.size());
+  if (indices.empty()) {
+    return;
+  }
+  using element_type = std::remove_pointer_t<
+    decltype(detail::GetProduct<Collection>::address(coll.cbegin()))>;
+  // All elements are converted to iToType by the same offset.
+  auto const offset = detail::upcastOffset(typeid(element_type), iToType);
+  oPtr.reserve(oPtr.size() + indices.size());
   for (auto const index : indices) {
     auto it = coll.cbegin();
     advance(it, index);
-    oPtr.push_back(detail::maybeCastObj(
-      detail::GetProduct<Collection>::address(it), iToType));
+    oPtr.push_back(detail::applyUpcastOffset(
+      detail::GetProduct<Collection>::address(it), offset));
   }
 }
 
@@ -86,23 +103,25 @@ art::getElementAddresses(cet::map_vector<T> const& obj,
                          std::vector<unsigned long> const& indices,
                          std::vector<void const*>& oPtr)
 {
-  detail::value_type_helper vh;
-  std::string const wanted_type =
-    uniform_type_name(cet::demangle_symbol(iToType.name()));
-  static size_t const pos = vh.look_past_pair<T>();
-  oPtr.reserve(indices.size());
-  if ((pos < wanted_type.size()) && vh.starts_with_pair(wanted_type, pos)) {
+  if (indices.empty()) {
+    return;
+  }
+  oPtr.reserve(oPtr.size() + indices.size());
+  if (detail::wantsMapVectorValueType(typeid(T), iToType)) {
     // Want value_type.
+    using value_type = typename cet::map_vector<T>::value_type;
+    auto const offset = detail::upcastOffset(typeid(value_type), iToType);
     for (auto const index : indices) {
       auto it = obj.find(cet::map_vector_key{index});
       auto ptr = (it == obj.cend()) ? nullptr : &*it;
-      oPtr.push_back(detail::maybeCastObj(ptr, iToType));
+      oPtr.push_back(detail::applyUpcastOffset(ptr, offset));
     }
   } else {
     // Want mapped_type.
+    auto const offset = detail::upcastOffset(typeid(T), iToType);
     for (auto const index : indices) {
       auto ptr = obj.getOrNull(cet::map_vector_key{index});
-      oPtr.push_back(detail::maybeCastObj(ptr, iToType));
+      oPtr.push_back(detail::applyUpcastOffset(ptr, offset));
     }
   }
 }
@@ -2,7 +2,8 @@
 #define canvas_Persistency_Common_setPtr_h
 
 #include "canvas/Persistency/Common/detail/maybeCastObj.h"
-#include "canvas/Utilities/uniform_type_name.h"
+#include "canvas/Persistency/Common/getElementAddresses.h"
+#include "canvas/Utilities/Exception.h"
 #include "cetlib/map_vector.h"
 #include "cetlib_except/demangle.h"
 
@@ -54,13 +55,9 @@ art::setPtr(cet::map_vector<T> const& obj,
             unsigned long iIndex,
             void const*& oPtr)
 {
-  detail::value_type_helper vh;
-  std::string const wanted_type =
-    uniform_type_name(cet::demangle_symbol(iToType.name()));
-  static size_t pos = vh.look_past_pair<T>();
   auto const it = obj.findOrThrow(cet::map_vector_key{iIndex});
   assert(it != obj.end());
-  if (pos < wanted_type.size() and vh.starts_with_pair(wanted_type, pos)) {
+  if (detail::wantsMapVectorValueType(typeid(T), iToType)) {
     // Want value_type, not mapped_type;
     oPtr = detail::maybeCastObj(&*it, iToType);
   } else {
@@ -15,6 +15,9 @@
 // The BranchDescription class is what retains information necessary for
 // interactions with ROOT.  The ProductDescription contains information
 // that is relevant for core framework processing.
+//
+// The ProductDescription class (see ProductDescription.h) provides
+// that core as a compact, immutable copy of a BranchDescription.
 // ================================================================================
 
 #include "canvas/Persistency/Provenance/BranchType.h"
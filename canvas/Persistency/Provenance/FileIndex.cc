@@ -3,11 +3,17 @@
 
 #include "canvas/Persistency/Provenance/RunID.h"
 #include "canvas/Persistency/Provenance/SubRunID.h"
+#include "canvas/Persistency/Provenance/detail/FileIndexDirectory.h"
+#include "canvas/Persistency/Provenance/detail/RunEventIndex.h"
+#include "canvas/Persistency/Provenance/detail/findEventBySubRunWalk.h"
 #include "cetlib/container_algorithms.h"
-#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "tbb/parallel_invoke.h"
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
 #include <iomanip>
+#include <memory>
 #include <ostream>
 
 using namespace cet;
@@ -15,15 +21,61 @@ using namespace std;
 
 namespace {
 
-  bool
-  subRunUnspecified(art::EventID const& eID)
-  {
-    // This is nasty, principally because we don't want to be
-    // encouraging too many people to do this. Basically, we're
-    // checking whether the only reason an EventID is invalid is
-    // because its subRun number is invalid.
-    return (!eID.isValid()) && eID.runID().isValid() &&
-           art::EventID(art::SubRunID::firstSubRun(), eID.event()).isValid();
+  // Below this size, a range is sorted serially.
+  constexpr std::ptrdiff_t serial_sort_cutoff{1 << 16};
+
+  template <typename RandomIt, typename Compare>
+  void
+  parallel_stable_sort(RandomIt const first,
+                       RandomIt const last,
+                       Compare const& cmp)
+  {
+    auto const n = last - first;
+    if (n <= serial_sort_cutoff) {
+      std::stable_sort(first, last, cmp);
+      return;
+    }
+    auto const middle = first + n / 2;
+    tbb::parallel_invoke(
+      [first, middle, &cmp] { parallel_stable_sort(first, middle, cmp); },
+      [middle, last, &cmp] { parallel_stable_sort(middle, last, cmp); });
+    std::inplace_merge(first, middle, last, cmp);
+  }
+
+  // Sort the entries unless they are already in order.  Only the range
+  // starting at 'from' needs to be checked: the entries before it are
+  // known to be sorted.
+  template <typename Compare>
+  void
+  sort_unless_sorted(std::vector<art::FileIndex::Element>& entries,
+                     Compare const& cmp,
+                     std::size_t const from = 0)
+  {
+    auto const b = begin(entries);
+    auto const e = end(entries);
+    auto const check_from = b + (from == 0 ? 0 : from - 1);
+    if (std::is_sorted(check_from, e, cmp)) {
+      return;
+    }
+    parallel_stable_sort(b, e, cmp);
+  }
+
+  // The lookup structure held by cache, built from the entries on
+  // first use.  Concurrent callers may each build one: the first one
+  // stored is kept, and returned to all of them.
+  template <typename T>
+  T const&
+  cachedLookup(std::shared_ptr<T const>& cache,
+               std::vector<art::FileIndex::Element> const& entries)
+  {
+    auto result = std::atomic_load(&cache);
+    if (!result) {
+      auto built = std::make_shared<T const>(entries);
+      if (std::atomic_compare_exchange_strong(&cache, &result, built)) {
+        result = std::move(built);
+      }
+    }
+    return *result;
   }
 
 } // unnamed namespace
@@ -49,6 +101,7 @@ namespace art {
   FileIndex::iterator
   FileIndex::begin()
   {
+    resetLookups();
     return entries_.begin();
   }
 
@@ -67,6 +120,7 @@ namespace art {
   FileIndex::iterator
   FileIndex::end()
   {
+    resetLookups();
     return entries_.end();
   }
 
@@ -112,6 +166,27 @@ namespace art {
     return transients_.get().sortState;
   }
 
+  detail::FileIndexDirectory const&
+  FileIndex::directory() const
+  {
+    assert(sortState() == kSorted_Run_SubRun_Event);
+    return cachedLookup(transients_.get().directory, entries_);
+  }
+
+  detail::RunEventIndex const&
+  FileIndex::runEventIndex() const
+  {
+    assert(sortState() == kSorted_Run_SubRun_Event);
+    return cachedLookup(transients_.get().runEventIndex, entries_);
+  }
+
+  void
+  FileIndex::resetLookups()
+  {
+    std::atomic_store(&transients_.get().directory, {});
+    std::atomic_store(&transients_.get().runEventIndex, {});
+  }
+
   bool
   FileIndex::contains(EventID const& id, bool exact) const
   {
@@ -136,6 +211,7 @@ namespace art {
     entries_.emplace_back(eID, entry);
     resultCached() = false;
     sortState() = kNotSorted;
+    resetLookups();
   }
 
   void
@@ -143,21 +219,58 @@ namespace art {
   {
     entries_.emplace_back(eID, entry);
     resultCached() = false;
+    resetLookups();
+  }
+
+  void
+  FileIndex::addEntriesOnLoad(std::vector<Element>&& entries)
+  {
+    auto const old_size = entries_.size();
+    if (entries_.empty()) {
+      entries_ = std::move(entries);
+    } else {
+      entries_.insert(entries_.end(),
+                      std::make_move_iterator(entries.begin()),
+                      std::make_move_iterator(entries.end()));
+    }
+    sortAfterBulkLoad(old_size);
+  }
+
+  void
+  FileIndex::addEntriesOnLoad(Element const* const first,
+                              Element const* const last)
+  {
+    auto const old_size = entries_.size();
+    entries_.insert(entries_.end(), first, last);
+    sortAfterBulkLoad(old_size);
+  }
+
+  void
+  FileIndex::sortAfterBulkLoad(std::size_t const old_size)
+  {
+    auto const from =
+      sortState() == kSorted_Run_SubRun_Event ? old_size : std::size_t{0};
+    sort_unless_sorted(entries_, std::less<Element>{}, from);
+    resultCached() = false;
+    resetLookups();
+    sortState() = kSorted_Run_SubRun_Event;
   }
 
   void
   FileIndex::sortBy_Run_SubRun_Event()
   {
-    stable_sort_all(entries_);
+    sort_unless_sorted(entries_, std::less<Element>{});
     resultCached() = false;
+    resetLookups();
     sortState() = kSorted_Run_SubRun_Event;
   }
 
   void
   FileIndex::sortBy_Run_SubRun_EventEntry()
   {
-    stable_sort_all(entries_, Compare_Run_SubRun_EventEntry());
+    sort_unless_sorted(entries_, Compare_Run_SubRun_EventEntry{});
     resultCached() = false;
+    resetLookups();
     sortState() = kSorted_Run_SubRun_EventEntry;
   }
 
@@ -227,43 +340,64 @@ namespace art {
   FileIndex::findPosition(EventID const& eID) const
   {
     assert(sortState() == kSorted_Run_SubRun_Event);
-    Element el{eID};
-    return lower_bound_all(entries_, el);
+    return entries_.cbegin() + directory().lowerBound(eID);
   }
 
   FileIndex::const_iterator
   FileIndex::findPosition(EventID const& eID, bool exact) const
   {
     assert(sortState() == kSorted_Run_SubRun_Event);
-    if (subRunUnspecified(eID)) {
+    if (detail::subRunUnspecified(eID)) {
       return findEventForUnspecifiedSubRun(eID, exact);
     }
-    const_iterator it = findPosition(eID);
-    const_iterator itEnd = entries_.end();
-    while (it != itEnd && it->getEntryType() != FileIndex::kEvent) {
-      ++it;
+    return entries_.cbegin() + directory().findEvent(eID, exact);
+  }
+
+  std::vector<FileIndex::const_iterator>
+  FileIndex::findPositions(span<EventID const> const eIDs,
+                           bool const exact) const
+  {
+    assert(sortState() == kSorted_Run_SubRun_Event);
+    std::vector<const_iterator> result(eIDs.size(), entries_.cend());
+
+    // Set aside the IDs with an unspecified subrun, and sort the rest.
+    std::vector<std::size_t> order;
+    order.reserve(eIDs.size());
+    for (std::size_t i = 0, n = eIDs.size(); i != n; ++i) {
+      if (detail::subRunUnspecified(eIDs[i])) {
+        result[i] = findEventForUnspecifiedSubRun(eIDs[i], exact);
+      } else {
+        order.push_back(i);
+      }
     }
-    if (it == itEnd) {
-      return itEnd;
+    auto const by_id = [eIDs](std::size_t const a, std::size_t const b) {
+      return eIDs[a] < eIDs[b];
+    };
+    if (!std::is_sorted(order.cbegin(), order.cend(), by_id)) {
+      std::sort(order.begin(), order.end(), by_id);
     }
-    if (exact && (*it != eID)) {
-      return itEnd;
+
+    std::vector<EventID> sorted;
+    sorted.reserve(order.size());
+    for (auto const i : order) {
+      sorted.push_back(eIDs[i]);
     }
-    return it;
+    auto const positions = directory().findEvents(sorted, exact);
+    for (std::size_t i = 0, n = order.size(); i != n; ++i) {
+      result[order[i]] = entries_.cbegin() + positions[i];
+    }
+    return result;
   }
 
   FileIndex::const_iterator
   FileIndex::findPosition(SubRunID const& srID, bool exact) const
   {
     assert(sortState() != kNotSorted);
-    const_iterator it;
-    auto const invID = EventID::invalidEvent(srID);
-    if (sortState() == kSorted_Run_SubRun_EventEntry) {
-      Element const el{invID};
-      it = lower_bound_all(entries_, el, Compare_Run_SubRun_EventEntry());
-    } else {
-      it = findPosition(invID);
+    if (sortState() == kSorted_Run_SubRun_Event) {
+      return entries_.cbegin() + directory().findSubRun(srID, exact);
     }
+    Element const el{EventID::invalidEvent(srID)};
+    auto it = lower_bound_all(entries_, el, Compare_Run_SubRun_EventEntry());
     auto const itEnd = entries_.cend();
     while (it != itEnd && it->getEntryType() != FileIndex::kSubRun) {
       ++it;
@@ -281,14 +415,11 @@ namespace art {
   FileIndex::findPosition(RunID const& rID, bool exact) const
   {
     assert(sortState() != kNotSorted);
-    const_iterator it;
-    auto const invID = EventID::invalidEvent(rID);
-    if (sortState() == kSorted_Run_SubRun_EventEntry) {
-      Element const el{invID};
-      it = lower_bound_all(entries_, el, Compare_Run_SubRun_EventEntry());
-    } else {
-      it = findPosition(invID);
+    if (sortState() == kSorted_Run_SubRun_Event) {
+      return entries_.cbegin() + directory().findRun(rID, exact);
     }
+    Element const el{EventID::invalidEvent(rID)};
+    auto it = lower_bound_all(entries_, el, Compare_Run_SubRun_EventEntry());
     auto const itEnd = entries_.cend();
     while (it != itEnd && it->getEntryType() != FileIndex::kRun) {
       ++it;
@@ -306,13 +437,11 @@ namespace art {
   FileIndex::findSubRunOrRunPosition(SubRunID const& srID) const
   {
     assert(sortState() != kNotSorted);
-    const_iterator it;
-    if (sortState() == kSorted_Run_SubRun_EventEntry) {
-      Element el{EventID::invalidEvent(srID)};
-      it = lower_bound_all(entries_, el, Compare_Run_SubRun_EventEntry());
-    } else {
-      it = findPosition(EventID::invalidEvent(srID));
+    if (sortState() == kSorted_Run_SubRun_Event) {
+      return entries_.cbegin() + directory().findSubRunOrRun(srID);
     }
+    Element const el{EventID::invalidEvent(srID)};
+    auto it = lower_bound_all(entries_, el, Compare_Run_SubRun_EventEntry());
     auto const itEnd = entries_.cend();
     while (it != itEnd && it->getEntryType() != FileIndex::kSubRun &&
            it->getEntryType() != FileIndex::kRun) {
@@ -346,69 +475,19 @@ namespace art {
   FileIndex::const_iterator
   FileIndex::findEventForUnspecifiedSubRun(EventID const& eID, bool exact) const
   {
-    RunID const& runID = eID.runID();
-    EventNumber_t event = eID.event();
-    SubRunID last_subRunID;
-    // Try to find the event.
-    auto const firstEvent =
-      findPosition(EventID::firstEvent(SubRunID::firstSubRun(runID)), false);
-    const_iterator it = firstEvent;
-    const_iterator const itEnd = entries_.end();
-    if (it == itEnd) {
-      return it;
-    }
-
-    // Starting with it, jump to the first event of each subrun until
-    // we find either:
-    //
-    // 1. The next run.
-    // 2. An event number higher than we want.
-    // 3. The end of the file index.
-    while ((it != itEnd) && (it->eventID.runID() == runID) &&
-           (it->eventID.event() < event)) {
-      last_subRunID = it->eventID.subRunID();
-      // Get the first event in the next subrun.
-      it =
-        findPosition(EventID::firstEvent(it->eventID.subRunID().next()), false);
-    }
-    const_iterator result = itEnd;
-    if ((it != itEnd) && (it->eventID.runID() == runID) &&
-        (it->eventID.event() == event)) {
-      // We started on the correct event.
-      result = it;
-    } else if (last_subRunID.isValid()) {
-      // Find the event in the last subrun.
-      result = findPosition(EventID(last_subRunID, event), exact);
-    }
-    if (result == itEnd) {
-      // Did not find anything.
-      mf::LogWarning("FileIndex")
-        << "Could not find incompletely specified event " << eID
-        << " with smart algorithm:\n"
-        << "Assuming pathological file structure (event selection?) and\n"
-        << "trying again (inefficient).\n"
-        << "NOTE: this will find only the event with matching event number "
-        << "and the\n"
-        << "      lowest subrun number: any others are inaccessible via this "
-        << "method.";
-      SubRunID trySubRun{SubRunID::firstSubRun(runID)};
-      // Try to find the highest subrun number in this run.
-      const_iterator findIt(firstEvent);
-      SubRunID lastSubRunInRun{trySubRun};
-      for (; findIt != itEnd && findIt->eventID.runID() == runID;
-           findIt =
-             findPosition(EventID::firstEvent(lastSubRunInRun.next()), false)) {
-        lastSubRunInRun = findIt->eventID.subRunID();
-      }
-      // Now loop through each subrun looking for an exact match to our event.
-      while ((findIt = findPosition(EventID(trySubRun, event), true)) ==
-               itEnd &&
-             trySubRun < lastSubRunInRun) {
-        trySubRun = trySubRun.next();
+    if (auto const pos = runEventIndex().find(eID.run(), eID.event(), exact)) {
+      // Warn whenever the subrun-by-subrun search would have: when it
+      // fails to find the event in a run with entries at or after it.
+      if (*pos == entries_.size() &&
+          findPosition(EventID::firstEvent(SubRunID::firstSubRun(eID.runID())),
+                       false) != cend()) {
+        detail::warnUnspecifiedSubRunSearch(eID);
       }
-      result = findIt;
+      return entries_.cbegin() + *pos;
     }
-    return result;
+    // The run's layout does not allow the event to be identified by
+    // the index: search subrun by subrun.
+    return detail::findEventBySubRunWalk(*this, eID, exact);
   }
 
   bool
@@ -461,7 +540,7 @@ namespace art {
 
   bool
   Compare_Run_SubRun_EventEntry::operator()(FileIndex::Element const& lh,
-                                            FileIndex::Element const& rh)
+                                            FileIndex::Element const& rh) const
   {
     if (lh.eventID.subRunID() == rh.eventID.subRunID()) {
       if ((!lh.eventID.isValid()) && (!rh.eventID.isValid())) {
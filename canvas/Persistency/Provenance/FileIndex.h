@@ -30,12 +30,19 @@
 #include "canvas/Persistency/Provenance/EventID.h"
 #include "canvas/Persistency/Provenance/Transient.h"
 #include "canvas/Persistency/Provenance/fwd.h"
+#include "canvas/Utilities/span.h"
 
 #include <iosfwd>
+#include <memory>
 #include <vector>
 
 namespace art {
 
+  namespace detail {
+    class FileIndexDirectory;
+    class RunEventIndex;
+  }
+
   class FileIndex {
   public:
     using EntryNumber_t = long long;
@@ -79,10 +86,32 @@ namespace art {
       // when we create a new FileIndex, the vector is empty, which is
       // consistent with it having been sorted.
       SortState sortState{kSorted_Run_SubRun_Event};
+
+      // Columnar search structure used for lookups when the index is
+      // sorted by Run, SubRun, and Event.  It is built on first use
+      // and discarded whenever the entries are added to or re-sorted.
+      // It is accessed only with the atomic shared_ptr operations, so
+      // that concurrent const lookups may race to build it: the first
+      // one built is kept.
+      std::shared_ptr<detail::FileIndexDirectory const> directory{};
+
+      // (run, event) index for lookups of events with an unspecified
+      // subrun, built on first such lookup and discarded along with the
+      // directory.  Accessed as the directory is.
+      std::shared_ptr<detail::RunEventIndex const> runEventIndex{};
     };
 
     void addEntry(EventID const& eID, EntryNumber_t entry);
     void addEntryOnLoad(EventID const& eID, EntryNumber_t entry);
+
+    // Bulk ingest.  The new entries are appended to any existing ones
+    // and the index is left sorted by Run, SubRun, and Event: if the
+    // combined entries are already in that order (as they are when
+    // read from a file written by RootOutput), no sort is done.
+    // Otherwise, a parallel stable sort is performed.
+    void addEntriesOnLoad(std::vector<Element>&& entries);
+    void addEntriesOnLoad(Element const* first, Element const* last);
+
     void sortBy_Run_SubRun_Event();
     void sortBy_Run_SubRun_EventEntry();
 
@@ -91,12 +120,25 @@ namespace art {
     const_iterator findPosition(SubRunID const& srID, bool exact) const;
     const_iterator findPosition(RunID const& rID, bool exact) const;
 
+    // Batch lookup: the result is the same as calling
+    // findPosition(eID, exact) for each ID, in the order given.  The
+    // IDs are sorted (if they are not already) so that the index can be
+    // traversed once, rather than searched from the beginning for each
+    // one.
+    std::vector<const_iterator> findPositions(span<EventID const> eIDs,
+                                              bool exact) const;
+
     const_iterator findSubRunOrRunPosition(SubRunID const& srID) const;
 
     bool contains(EventID const& id, bool exact) const;
     bool contains(SubRunID const& id, bool exact) const;
     bool contains(RunID const& id, bool exact) const;
 
+    // The non-const begin() and end() discard the lookup structures,
+    // which are rebuilt from the entries by the next lookup.  Entries
+    // modified through the iterators they return must be left in the
+    // order of the index, or the index re-sorted, and must not be
+    // modified concurrently with any other use of the index.
     iterator begin();
     const_iterator begin() const;
     const_iterator cbegin() const;
@@ -120,6 +162,10 @@ namespace art {
     bool& allInEntryOrder() const;
     bool& resultCached() const;
     SortState& sortState() const;
+    detail::FileIndexDirectory const& directory() const;
+    detail::RunEventIndex const& runEventIndex() const;
+    void resetLookups();
+    void sortAfterBulkLoad(std::size_t old_size);
     const_iterator findEventForUnspecifiedSubRun(EventID const& eID,
                                                  bool exact) const;
 
@@ -138,7 +184,8 @@ namespace art {
   bool operator!=(FileIndex const& lh, FileIndex const& rh);
 
   struct Compare_Run_SubRun_EventEntry {
-    bool operator()(FileIndex::Element const& lh, FileIndex::Element const& rh);
+    bool operator()(FileIndex::Element const& lh,
+                    FileIndex::Element const& rh) const;
   };
 
   std::ostream& operator<<(std::ostream& os, FileIndex::Element const& el);
@@ -3,6 +3,8 @@
 #include "cetlib/MD5Digest.h"
 #include "cetlib/container_algorithms.h"
 
+#include <algorithm>
+
 namespace {
   std::string const invalid{cet::MD5Result{}.compactForm()};
 }
@@ -30,6 +32,20 @@ namespace art::detail {
       << hash << "\nPlease report this to the core framework developers";
   }
 
+  hash_bytes_t
+  hash_bytes(std::string const& hash)
+  {
+    hash_bytes_t result;
+    if (hash.size() == result.size()) {
+      std::copy(hash.cbegin(), hash.cend(), result.begin());
+      return result;
+    }
+    std::string compact{hash};
+    fixup(compact);
+    std::copy(compact.cbegin(), compact.cend(), result.begin());
+    return result;
+  }
+
   std::string
   hash_to_string(std::string const& hash)
   {
@@ -38,10 +54,31 @@ namespace art::detail {
     return temp.toString();
   }
 
+  std::string
+  hash_to_string(hash_bytes_t const& hash)
+  {
+    cet::MD5Result temp;
+    cet::copy_all(hash, temp.bytes);
+    return temp.toString();
+  }
+
   // This string is the 16-byte, non-printable version.
   std::string const&
   InvalidHash()
   {
     return invalid;
   }
+
+  // A function-local static, so that Hash objects may be created
+  // during static initialization.
+  hash_bytes_t const&
+  InvalidHashBytes()
+  {
+    static hash_bytes_t const invalid_bytes = [] {
+      hash_bytes_t result;
+      cet::copy_all(cet::MD5Result{}.bytes, result.begin());
+      return result;
+    }();
+    return invalid_bytes;
+  }
 }
@@ -4,30 +4,49 @@
 
 // ======================================================================
 //
-// Hash:
+// Hash: an MD5 digest.
 //
-// Note: The call to 'fixup' in every member function is a temporary
-// measure for backwards compatibility. It is necessary in every function
-// because Root creates instances of the class *without* using the
-// interface of the class, thus making it insufficient to assure that all
-// constructors make corrected instances.
+// The digest is held, and persisted, as the data member 'std::string
+// hash_'.  Every instance made through the interface of the class holds
+// it in the 16 byte (non-printable) form.  Comparing, hashing and
+// printing read those bytes in place, without modifying or copying the
+// string.
+//
+// Note: ROOT creates instances of the class *without* using its
+// interface: it default-constructs them and then sets 'hash_', which in
+// files written by old versions of art is in the 32 byte (hexified)
+// form.  Each operation therefore checks the size of 'hash_', and
+// converts a hexified digest on the fly; no state other than 'hash_' is
+// kept, so that an instance that ROOT reads into again is never stale.
 //
 // ======================================================================
 
 #include "canvas/Utilities/Exception.h"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <ostream>
 #include <string>
 
 namespace art {
 
   namespace detail {
+    using hash_bytes_t = std::array<unsigned char, 16>;
+
     // If hash is in the hexified 32 byte representation, make it be
     // in the 16 byte unhexified representation.
     void fixup(std::string& hash);
+    // The 16 bytes of a hash given in any representation accepted by
+    // fixup().
+    hash_bytes_t hash_bytes(std::string const& hash);
     std::string hash_to_string(std::string const& hash);
+    std::string hash_to_string(hash_bytes_t const& hash);
     // This string is in the 16 byte (non-printable) representation.
     std::string const& InvalidHash();
+    hash_bytes_t const& InvalidHashBytes();
   } // namespace detail
 
   template <int I>
@@ -51,6 +70,7 @@ namespace art {
     // string, nor from any string that is not a valid string
     // representation of an MD5 checksum.
     bool isValid() const;
+    // Always true: the hash is only presented in compact form.
     bool isCompactForm() const noexcept;
     // Return the 16 byte (non-printable) string form.
     std::string compactForm() const;
@@ -61,7 +81,13 @@ namespace art {
     std::ostream& print(std::ostream&) const;
     void swap(Hash<I>&);
 
+    // The bytes, as two 64-bit words, for use in hash tables.
+    std::size_t hash() const;
+
   private:
+    detail::hash_bytes_t bytes() const;
+    int compare(Hash<I> const&) const;
+
     std::string hash_{};
   };
 
@@ -74,10 +100,8 @@ namespace art {
   }
 
   template <int I>
-  Hash<I>::Hash()
-  {
-    detail::fixup(hash_);
-  }
+  Hash<I>::Hash() : hash_{detail::InvalidHash()}
+  {}
 
   template <int I>
   Hash<I>::Hash(std::string const& s) : hash_{s}
@@ -88,13 +112,19 @@ namespace art {
   template <int I>
   Hash<I>::Hash(Hash<I> const& rhs) : hash_{rhs.hash_}
   {
-    detail::fixup(hash_);
+    if (hash_.size() != 16) {
+      detail::fixup(hash_);
+    }
   }
 
+  // The moved-from object holds no digest, which reads as the invalid
+  // one.
   template <int I>
   Hash<I>::Hash(Hash<I>&& rhs) : hash_{std::move(rhs.hash_)}
   {
-    detail::fixup(hash_);
+    if (hash_.size() != 16) {
+      detail::fixup(hash_);
+    }
   }
 
   template <int I>
@@ -103,7 +133,9 @@ namespace art {
   {
     if (this != &rhs) {
       hash_ = rhs.hash_;
-      detail::fixup(hash_);
+      if (hash_.size() != 16) {
+        detail::fixup(hash_);
+      }
     }
     return *this;
   }
@@ -112,52 +144,66 @@ namespace art {
   Hash<I>&
   Hash<I>::operator=(Hash<I>&& rhs)
   {
-    hash_ = std::move(rhs.hash_);
-    detail::fixup(hash_);
+    if (this != &rhs) {
+      hash_ = std::move(rhs.hash_);
+      if (hash_.size() != 16) {
+        detail::fixup(hash_);
+      }
+    }
     return *this;
   }
 
+  template <int I>
+  detail::hash_bytes_t
+  Hash<I>::bytes() const
+  {
+    if (hash_.size() != 16) {
+      return detail::hash_bytes(hash_);
+    }
+    detail::hash_bytes_t result;
+    std::memcpy(result.data(), hash_.data(), result.size());
+    return result;
+  }
+
   template <int I>
   bool
   Hash<I>::isValid() const
   {
-    if (isCompactForm()) {
-      return hash_ != art::detail::InvalidHash();
+    return bytes() != detail::InvalidHashBytes();
+  }
+
+  template <int I>
+  int
+  Hash<I>::compare(Hash<I> const& rhs) const
+  {
+    // The same ordering as that of the compact string forms.
+    if (hash_.size() == 16 && rhs.hash_.size() == 16) {
+      return hash_.compare(rhs.hash_);
     }
-    return !hash_.empty();
+    auto const lhs_bytes = bytes();
+    auto const rhs_bytes = rhs.bytes();
+    return std::memcmp(lhs_bytes.data(), rhs_bytes.data(), lhs_bytes.size());
   }
 
   template <int I>
   bool
   Hash<I>::operator<(Hash<I> const& rhs) const
   {
-    if (isCompactForm() == rhs.isCompactForm()) {
-      return hash_ < rhs.hash_;
-    }
-    // Force both into compact form.
-    return Hash<I>{*this} < Hash<I>{rhs};
+    return compare(rhs) < 0;
   }
 
   template <int I>
   bool
   Hash<I>::operator>(Hash<I> const& rhs) const
   {
-    if (isCompactForm() == rhs.isCompactForm()) {
-      return hash_ > rhs.hash_;
-    }
-    // Force both into compact form.
-    return Hash<I>{*this} > Hash<I>{rhs};
+    return compare(rhs) > 0;
   }
 
   template <int I>
   bool
   Hash<I>::operator==(Hash<I> const& rhs) const
   {
-    if (isCompactForm() == rhs.isCompactForm()) {
-      return hash_ == rhs.hash_;
-    }
-    // Force both into compact form.
-    return Hash<I>{*this} == Hash<I>{rhs};
+    return compare(rhs) == 0;
   }
 
   template <int I>
@@ -171,35 +217,43 @@ namespace art {
   std::ostream&
   Hash<I>::print(std::ostream& os) const
   {
-    Hash<I> tMe{*this};
-    return os << detail::hash_to_string(tMe.hash_);
+    return os << detail::hash_to_string(bytes());
   }
 
   template <int I>
   void
   Hash<I>::swap(Hash<I>& rhs)
   {
-    detail::fixup(hash_);
     hash_.swap(rhs.hash_);
-    detail::fixup(hash_);
+  }
+
+  template <int I>
+  std::size_t
+  Hash<I>::hash() const
+  {
+    auto const digest = bytes();
+    std::uint64_t words[2];
+    std::memcpy(words, digest.data(), sizeof(words));
+    // The bytes of an MD5 digest are uniformly distributed.
+    return static_cast<std::size_t>(words[0] ^ words[1]);
   }
 
   template <int I>
   std::string
   Hash<I>::compactForm() const
   {
-    if (isCompactForm()) {
+    if (hash_.size() == 16) {
       return hash_;
     }
-    Hash<I> tMe(*this);
-    return tMe.compactForm();
+    auto const digest = bytes();
+    return std::string(digest.cbegin(), digest.cend());
   }
 
   template <int I>
   bool
   Hash<I>::isCompactForm() const noexcept
   {
-    return hash_.size() == 16;
+    return true;
   }
 
   template <int I>
@@ -218,6 +272,17 @@ namespace art {
 
 } // namespace art
 
+namespace std {
+  template <int I>
+  struct hash<art::Hash<I>> {
+    std::size_t
+    operator()(art::Hash<I> const& h) const
+    {
+      return h.hash();
+    }
+  };
+}
+
 #endif /* canvas_Persistency_Provenance_Hash_h */
 
 // Local Variables:
@@ -0,0 +1,321 @@
+#include "canvas/Persistency/Provenance/MappedFileIndex.h"
+// vim: set sw=2 expandtab :
+
+#include "canvas/Persistency/Provenance/RunID.h"
+#include "canvas/Persistency/Provenance/SubRunID.h"
+#include "canvas/Persistency/Provenance/detail/findEventBySubRunWalk.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using art::FileIndex;
+using art::MappedFileIndex;
+
+namespace {
+
+  // The fixed-width file header.  The elements follow immediately.
+  struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t elementSize;
+    std::uint32_t reserved;
+    std::uint64_t size;
+  };
+
+  constexpr char fileMagic[8]{'a', 'r', 't', 'F', 'I', 'd', 'x', '\0'};
+  constexpr std::uint32_t byteOrderMark{0x01020304};
+
+  // The layout of each element on disk: that of FileIndex::Element,
+  // with the padding zeroed.
+  struct Record {
+    std::uint32_t run;
+    std::uint32_t subRun;
+    std::uint32_t event;
+    std::uint32_t padding;
+    std::int64_t entry;
+  };
+
+  static_assert(sizeof(Header) == 32);
+  static_assert(std::is_trivially_copyable_v<FileIndex::Element>);
+  static_assert(std::is_standard_layout_v<FileIndex::Element>);
+  static_assert(sizeof(art::EventID) == 3 * sizeof(std::uint32_t));
+  static_assert(sizeof(Record) == sizeof(FileIndex::Element));
+  static_assert(offsetof(FileIndex::Element, entry) == offsetof(Record, entry));
+
+  bool
+  isType(FileIndex::Element const& e, FileIndex::EntryType const type)
+  {
+    return e.getEntryType() == type;
+  }
+
+  [[noreturn]] void
+  throwReadError(std::string const& filename, std::string const& why)
+  {
+    throw art::Exception{art::errors::FileReadError}
+      << "Unable to use '" << filename << "' as a mapped FileIndex: " << why
+      << '\n';
+  }
+
+} // unnamed namespace
+
+namespace art {
+
+  void
+  MappedFileIndex::write(FileIndex const& index, std::string const& filename)
+  {
+    if (!std::is_sorted(index.cbegin(), index.cend())) {
+      throw Exception{errors::LogicError}
+        << "A FileIndex must be sorted by Run, SubRun, and Event number to "
+           "be written to '"
+        << filename << "'.\n";
+    }
+    std::ofstream os{filename, std::ios::binary | std::ios::trunc};
+    if (!os) {
+      throw Exception{errors::FileOpenError}
+        << "Unable to open '" << filename << "' for writing.\n";
+    }
+
+    Header header{};
+    std::copy(std::begin(fileMagic), std::end(fileMagic), header.magic);
+    header.version = version;
+    header.byteOrder = byteOrderMark;
+    header.elementSize = sizeof(Record);
+    header.size = index.size();
+    os.write(reinterpret_cast<char const*>(&header), sizeof(header));
+
+    // Write the elements in blocks.
+    constexpr std::size_t block_size{4096};
+    std::vector<Record> block;
+    block.reserve(block_size);
+    auto flush = [&os, &block] {
+      os.write(reinterpret_cast<char const*>(block.data()),
+               block.size() * sizeof(Record));
+      block.clear();
+    };
+    for (auto const& element : index) {
+      Record record;
+      std::memcpy(&record, &element, sizeof(record));
+      record.padding = 0;
+      block.push_back(record);
+      if (block.size() == block_size) {
+        flush();
+      }
+    }
+    flush();
+    if (!os.flush()) {
+      throw Exception{errors::FileOpenError}
+        << "Error writing mapped FileIndex to '" << filename << "'.\n";
+    }
+  }
+
+  MappedFileIndex::MappedFileIndex(std::string const& filename)
+  {
+    int const fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+      throw Exception{errors::FileOpenError}
+        << "Unable to open '" << filename << "': " << std::strerror(errno)
+        << '\n';
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) == -1) {
+      ::close(fd);
+      throwReadError(filename, std::strerror(errno));
+    }
+    auto const fileSize = static_cast<std::size_t>(st.st_size);
+    if (fileSize < sizeof(Header)) {
+      ::close(fd);
+      throwReadError(filename, "the file is too short to hold a header");
+    }
+    void* const mapping =
+      ::mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+      throwReadError(filename, std::strerror(errno));
+    }
+    mapping_ = mapping;
+    mappingSize_ = fileSize;
+
+    Header header;
+    std::memcpy(&header, mapping, sizeof(header));
+    std::string why;
+    if (!std::equal(
+          std::begin(fileMagic), std::end(fileMagic), header.magic)) {
+      why = "it is not a FileIndex file";
+    } else if (header.byteOrder != byteOrderMark) {
+      why = "it was written with a different byte order";
+    } else if (header.version != version) {
+      why = "its format version (" + std::to_string(header.version) +
+            ") is not supported";
+    } else if (header.elementSize != sizeof(Record) ||
+               // Checked first, so that the product cannot overflow.
+               header.size > (fileSize - sizeof(Header)) / sizeof(Record) ||
+               fileSize != sizeof(Header) + header.size * sizeof(Record)) {
+      why = "its size is inconsistent with its header";
+    }
+    if (!why.empty()) {
+      ::munmap(mapping_, mappingSize_);
+      throwReadError(filename, why);
+    }
+    elements_ = reinterpret_cast<Element const*>(
+      static_cast<char const*>(mapping) + sizeof(Header));
+    size_ = header.size;
+  }
+
+  MappedFileIndex::~MappedFileIndex()
+  {
+    if (mapping_ != nullptr) {
+      ::munmap(mapping_, mappingSize_);
+    }
+  }
+
+  MappedFileIndex::MappedFileIndex(MappedFileIndex&& other) noexcept
+    : mapping_{std::exchange(other.mapping_, nullptr)}
+    , mappingSize_{std::exchange(other.mappingSize_, 0)}
+    , elements_{std::exchange(other.elements_, nullptr)}
+    , size_{std::exchange(other.size_, 0)}
+  {}
+
+  MappedFileIndex&
+  MappedFileIndex::operator=(MappedFileIndex&& other) noexcept
+  {
+    std::swap(mapping_, other.mapping_);
+    std::swap(mappingSize_, other.mappingSize_);
+    std::swap(elements_, other.elements_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+
+  MappedFileIndex::const_iterator
+  MappedFileIndex::begin() const
+  {
+    return elements_;
+  }
+
+  MappedFileIndex::const_iterator
+  MappedFileIndex::cbegin() const
+  {
+    return elements_;
+  }
+
+  MappedFileIndex::const_iterator
+  MappedFileIndex::end() const
+  {
+    return elements_ + size_;
+  }
+
+  MappedFileIndex::const_iterator
+  MappedFileIndex::cend() const
+  {
+    return elements_ + size_;
+  }
+
+  std::size_t
+  MappedFileIndex::size() const
+  {
+    return size_;
+  }
+
+  bool
+  MappedFileIndex::empty() const
+  {
+    return size_ == 0;
+  }
+
+  template <typename Match>
+  MappedFileIndex::const_iterator
+  MappedFileIndex::firstMatchAtOrAfter_(EventID const& eID, Match match) const
+  {
+    auto it = findPosition(eID);
+    auto const itEnd = cend();
+    while (it != itEnd && !match(*it)) {
+      ++it;
+    }
+    return it;
+  }
+
+  MappedFileIndex::const_iterator
+  MappedFileIndex::findPosition(EventID const& eID) const
+  {
+    return std::lower_bound(cbegin(), cend(), Element{eID});
+  }
+
+  MappedFileIndex::const_iterator
+  MappedFileIndex::findPosition(EventID const& eID, bool const exact) const
+  {
+    if (detail::subRunUnspecified(eID)) {
+      return detail::findEventBySubRunWalk(*this, eID, exact);
+    }
+    auto const it = firstMatchAtOrAfter_(
+      eID, [](Element const& e) { return isType(e, FileIndex::kEvent); });
+    if (it == cend() || (exact && it->eventID != eID)) {
+      return cend();
+    }
+    return it;
+  }
+
+  MappedFileIndex::const_iterator
+  MappedFileIndex::findPosition(SubRunID const& srID, bool const exact) const
+  {
+    auto const it =
+      firstMatchAtOrAfter_(EventID::invalidEvent(srID), [](Element const& e) {
+        return isType(e, FileIndex::kSubRun);
+      });
+    if (it == cend() || (exact && it->eventID.subRunID() != srID)) {
+      return cend();
+    }
+    return it;
+  }
+
+  MappedFileIndex::const_iterator
+  MappedFileIndex::findPosition(RunID const& rID, bool const exact) const
+  {
+    auto const it =
+      firstMatchAtOrAfter_(EventID::invalidEvent(rID), [](Element const& e) {
+        return isType(e, FileIndex::kRun);
+      });
+    if (it == cend() || (exact && it->eventID.runID() != rID)) {
+      return cend();
+    }
+    return it;
+  }
+
+  MappedFileIndex::const_iterator
+  MappedFileIndex::findSubRunOrRunPosition(SubRunID const& srID) const
+  {
+    return firstMatchAtOrAfter_(
+      EventID::invalidEvent(srID),
+      [](Element const& e) { return !isType(e, FileIndex::kEvent); });
+  }
+
+  bool
+  MappedFileIndex::contains(EventID const& id, bool const exact) const
+  {
+    return findPosition(id, exact) != cend();
+  }
+
+  bool
+  MappedFileIndex::contains(SubRunID const& id, bool const exact) const
+  {
+    return findPosition(id, exact) != cend();
+  }
+
+  bool
+  MappedFileIndex::contains(RunID const& id, bool const exact) const
+  {
+    return findPosition(id, exact) != cend();
+  }
+
+} // namespace art
@@ -0,0 +1,85 @@
+#ifndef canvas_Persistency_Provenance_MappedFileIndex_h
+#define canvas_Persistency_Provenance_MappedFileIndex_h
+// vim: set sw=2 expandtab :
+
+////////////////////////////////////////////////////////////////////////
+//
+// MappedFileIndex: a read-only, memory-mapped view of a FileIndex that
+// has been written to a sidecar file with MappedFileIndex::write().
+//
+// The file consists of a fixed-width, versioned header followed by the
+// FileIndex elements, sorted by Run, SubRun, and Event number, in a
+// binary layout identical to that of FileIndex::Element in memory.
+// Opening the file maps it into memory: no element is parsed or copied
+// and no heap allocation is done for them, so checking whether a file
+// contains a given run, subrun or event costs little more than the
+// page faults of a binary search.
+//
+// The lookup functions have the same semantics as those of a FileIndex
+// sorted by Run, SubRun, and Event number.  Files are only readable on
+// a platform with the same byte order as that of the writer.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "canvas/Persistency/Provenance/FileIndex.h"
+
+#include <cstddef>
+#include <string>
+
+namespace art {
+
+  class MappedFileIndex {
+  public:
+    using Element = FileIndex::Element;
+    using const_iterator = Element const*;
+
+    static constexpr unsigned version{1};
+
+    // Throws an art::Exception if the index is not sorted by Run,
+    // SubRun, and Event number, or if the file cannot be written.
+    static void write(FileIndex const& index, std::string const& filename);
+
+    explicit MappedFileIndex(std::string const& filename);
+    ~MappedFileIndex();
+
+    MappedFileIndex(MappedFileIndex const&) = delete;
+    MappedFileIndex& operator=(MappedFileIndex const&) = delete;
+    MappedFileIndex(MappedFileIndex&& other) noexcept;
+    MappedFileIndex& operator=(MappedFileIndex&& other) noexcept;
+
+    const_iterator findPosition(EventID const& eID) const;
+    const_iterator findPosition(EventID const& eID, bool exact) const;
+    const_iterator findPosition(SubRunID const& srID, bool exact) const;
+    const_iterator findPosition(RunID const& rID, bool exact) const;
+
+    const_iterator findSubRunOrRunPosition(SubRunID const& srID) const;
+
+    bool contains(EventID const& id, bool exact) const;
+    bool contains(SubRunID const& id, bool exact) const;
+    bool contains(RunID const& id, bool exact) const;
+
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+    const_iterator end() const;
+    const_iterator cend() const;
+
+    std::size_t size() const;
+    bool empty() const;
+
+  private:
+    template <typename Match>
+    const_iterator firstMatchAtOrAfter_(EventID const& eID, Match match) const;
+
+    void* mapping_{nullptr};
+    std::size_t mappingSize_{};
+    Element const* elements_{nullptr};
+    std::size_t size_{};
+  };
+
+} // namespace art
+
+#endif /* canvas_Persistency_Provenance_MappedFileIndex_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,104 @@
+#include "canvas/Persistency/Provenance/ProductDescription.h"
+// vim: set sw=2 expandtab :
+
+#include "canvas/Persistency/Provenance/BranchDescription.h"
+#include "canvas/Persistency/Provenance/canonicalProductName.h"
+#include "canvas/Utilities/WrappedClassName.h"
+
+#include <ostream>
+
+using namespace art;
+
+namespace {
+
+  // Racing threads compute and intern the same string, so whichever
+  // stores its address first, the address is the same.
+  template <typename F>
+  std::string const&
+  interned_once(std::atomic<std::string const*>& cache, F compute)
+  {
+    if (auto const cached = cache.load(std::memory_order_acquire)) {
+      return *cached;
+    }
+    auto const* const result = &InternedString{compute()}.str();
+    cache.store(result, std::memory_order_release);
+    return *result;
+  }
+
+} // unnamed namespace
+
+art::ProductDescription::ProductDescription(BranchDescription const& bd)
+  : moduleLabel_{bd.moduleLabel()}
+  , processName_{bd.processName()}
+  , producedClassName_{bd.producedClassName()}
+  , friendlyClassName_{bd.friendlyClassName()}
+  , productInstanceName_{bd.productInstanceName()}
+  , productID_{bd.productID()}
+  , branchType_{bd.branchType()}
+  , supportsView_{bd.supportsView()}
+{}
+
+art::ProductDescription::ProductDescription(
+  ProductDescription const& other) noexcept
+  : moduleLabel_{other.moduleLabel_}
+  , processName_{other.processName_}
+  , producedClassName_{other.producedClassName_}
+  , friendlyClassName_{other.friendlyClassName_}
+  , productInstanceName_{other.productInstanceName_}
+  , branchName_{other.branchName_.load(std::memory_order_acquire)}
+  , wrappedName_{other.wrappedName_.load(std::memory_order_acquire)}
+  , productID_{other.productID_}
+  , branchType_{other.branchType_}
+  , supportsView_{other.supportsView_}
+{}
+
+std::string const&
+art::ProductDescription::branchName() const
+{
+  return interned_once(branchName_, [this] {
+    return canonicalProductName(friendlyClassName(),
+                                moduleLabel(),
+                                productInstanceName(),
+                                processName());
+  });
+}
+
+std::string const&
+art::ProductDescription::wrappedName() const
+{
+  return interned_once(
+    wrappedName_, [this] { return wrappedClassName(producedClassName()); });
+}
+
+bool
+art::operator==(ProductDescription const& a,
+                ProductDescription const& b) noexcept
+{
+  // The friendly class name is derived from the produced class name.
+  return a.productID_ == b.productID_ && a.branchType_ == b.branchType_ &&
+         a.supportsView_ == b.supportsView_ &&
+         a.moduleLabel_ == b.moduleLabel_ &&
+         a.processName_ == b.processName_ &&
+         a.producedClassName_ == b.producedClassName_ &&
+         a.productInstanceName_ == b.productInstanceName_;
+}
+
+bool
+art::operator!=(ProductDescription const& a,
+                ProductDescription const& b) noexcept
+{
+  return !(a == b);
+}
+
+std::ostream&
+art::operator<<(std::ostream& os, ProductDescription const& pd)
+{
+  os << "Branch Type = " << pd.branchType() << '\n';
+  os << "Process Name = " << pd.processName() << '\n';
+  os << "ModuleLabel = " << pd.moduleLabel() << '\n';
+  os << "Product ID = " << pd.productID() << '\n';
+  os << "Class Name = " << pd.producedClassName() << '\n';
+  os << "Friendly Class Name = " << pd.friendlyClassName() << '\n';
+  os << "Product Instance Name = " << pd.productInstanceName() << '\n';
+  return os;
+}
@@ -0,0 +1,162 @@
+#ifndef canvas_Persistency_Provenance_ProductDescription_h
+#define canvas_Persistency_Provenance_ProductDescription_h
+// vim: set sw=2 expandtab :
+
+////////////////////////////////////////////////////////////////////////
+//
+// ProductDescription: the immutable core of a BranchDescription, i.e.
+// the information relevant for core framework processing.
+//
+// The names are interned strings (see InternedString.h): each distinct
+// name is stored once for the whole program, and a ProductDescription
+// holds only pointers to the names, so that it is small and cheap to
+// copy, and its names are compared by address.
+//
+// The branch name and the wrapped class name, which are needed only
+// for interactions with ROOT, are derived from the names on first use,
+// and then interned as well.  A ProductDescription may be used from
+// several threads at once.
+//
+// The parameter-set and process-configuration IDs, and the ROOT
+// branch attributes (split level, etc.), remain in the
+// BranchDescription.
+//
+// A ProductTable holds the ProductDescription of each of its products,
+// from which its product and view lookups are built, by shared pointer:
+// the copies of a table share its descriptions.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "canvas/Persistency/Provenance/BranchType.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Persistency/Provenance/fwd.h"
+#include "canvas/Utilities/InputTag.h"
+#include "canvas/Utilities/InternedString.h"
+
+#include <atomic>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace art {
+
+  class ProductDescription {
+    friend bool operator==(ProductDescription const&,
+                           ProductDescription const&) noexcept;
+
+  public:
+    ProductDescription() = default;
+    explicit ProductDescription(BranchDescription const& bd);
+
+    // Immutable: a description may be copied, but not assigned to.
+    ProductDescription(ProductDescription const& other) noexcept;
+    ProductDescription& operator=(ProductDescription const&) = delete;
+
+    std::string const&
+    moduleLabel() const noexcept
+    {
+      return moduleLabel_.str();
+    }
+    std::string const&
+    processName() const noexcept
+    {
+      return processName_.str();
+    }
+    std::string const&
+    producedClassName() const noexcept
+    {
+      return producedClassName_.str();
+    }
+    std::string const&
+    friendlyClassName() const noexcept
+    {
+      return friendlyClassName_.str();
+    }
+    std::string const&
+    productInstanceName() const noexcept
+    {
+      return productInstanceName_.str();
+    }
+    InputTag
+    inputTag() const
+    {
+      return InputTag{moduleLabel(), productInstanceName(), processName()};
+    }
+
+    // The names as interned strings, for comparisons and lookups.
+    InternedString
+    internedModuleLabel() const noexcept
+    {
+      return moduleLabel_;
+    }
+    InternedString
+    internedProcessName() const noexcept
+    {
+      return processName_;
+    }
+    InternedString
+    internedFriendlyClassName() const noexcept
+    {
+      return friendlyClassName_;
+    }
+    InternedString
+    internedProductInstanceName() const noexcept
+    {
+      return productInstanceName_;
+    }
+
+    ProductID
+    productID() const noexcept
+    {
+      return productID_;
+    }
+    BranchType
+    branchType() const noexcept
+    {
+      return branchType_;
+    }
+    bool
+    supportsView() const noexcept
+    {
+      return supportsView_;
+    }
+
+    std::string const& branchName() const;
+    std::string const& wrappedName() const;
+
+  private:
+    InternedString moduleLabel_{};
+    InternedString processName_{};
+    InternedString producedClassName_{};
+    InternedString friendlyClassName_{};
+    InternedString productInstanceName_{};
+
+    // Null until first used.
+    mutable std::atomic<std::string const*> branchName_{nullptr};
+    mutable std::atomic<std::string const*> wrappedName_{nullptr};
+
+    ProductID productID_{};
+    BranchType branchType_{InEvent};
+    bool supportsView_{false};
+  };
+
+  // Shared, immutable descriptions, e.g. by the copies of a
+  // ProductTable.
+  using CoreDescriptionsByID =
+    std::map<ProductID, std::shared_ptr<ProductDescription const>>;
+
+  bool operator==(ProductDescription const&,
+                  ProductDescription const&) noexcept;
+  bool operator!=(ProductDescription const&,
+                  ProductDescription const&) noexcept;
+
+  std::ostream& operator<<(std::ostream&, ProductDescription const&);
+
+} // namespace art
+
+#endif /* canvas_Persistency_Provenance_ProductDescription_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,59 @@
+#include "canvas/Persistency/Provenance/ProductDescriptionIndex.h"
+// vim: set sw=2 expandtab :
+
+#include <utility>
+
+using namespace art;
+
+art::ProductDescriptionIndex::ProductDescriptionIndex(
+  ProductDescriptionsByID const& pds)
+{
+  std::size_t n_slots{16};
+  while (n_slots < 2 * pds.size()) {
+    n_slots *= 2;
+  }
+  rehash(n_slots);
+  for (auto const& [pid, pd] : pds) {
+    place(pid.value(), &pd);
+  }
+}
+
+void
+art::ProductDescriptionIndex::insert(BranchDescription const& pd)
+{
+  if (2 * (size_ + 1) > slots_.size()) {
+    rehash(slots_.empty() ? 16 : 2 * slots_.size());
+  }
+  place(pd.productID().value(), &pd);
+}
+
+void
+art::ProductDescriptionIndex::rehash(std::size_t const n_slots)
+{
+  auto old_slots = std::exchange(slots_, std::vector<Slot>(n_slots));
+  mask_ = static_cast<ProductID::value_type>(n_slots - 1);
+  size_ = 0;
+  for (auto const& slot : old_slots) {
+    if (slot.description != nullptr) {
+      place(slot.key, slot.description);
+    }
+  }
+}
+
+void
+art::ProductDescriptionIndex::place(ProductID::value_type const key,
+                                    BranchDescription const* const pd)
+{
+  for (auto i = key & mask_;; i = (i + 1) & mask_) {
+    auto& slot = slots_[i];
+    if (slot.description == nullptr) {
+      slot = Slot{key, pd};
+      ++size_;
+      return;
+    }
+    if (slot.key == key) {
+      slot.description = pd;
+      return;
+    }
+  }
+}
@@ -0,0 +1,88 @@
+#ifndef canvas_Persistency_Provenance_ProductDescriptionIndex_h
+#define canvas_Persistency_Provenance_ProductDescriptionIndex_h
+// vim: set sw=2 expandtab :
+
+////////////////////////////////////////////////////////////////////////
+//
+// ProductDescriptionIndex: the descriptions of products by product ID,
+// in an open-addressing hash table.
+//
+// The index does not own the descriptions: it stores their addresses,
+// which must remain valid for as long as the index is used (as do the
+// addresses of the elements of a ProductDescriptionsByID map).  Since
+// a product ID is already a checksum, its low bits are used directly
+// as the position of its slot; with a load factor of at most one half,
+// a lookup almost always reads a single slot.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "canvas/Persistency/Provenance/BranchDescription.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "cetlib/exempt_ptr.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace art {
+
+  class ProductDescriptionIndex {
+  public:
+    ProductDescriptionIndex() = default;
+    explicit ProductDescriptionIndex(ProductDescriptionsByID const& pds);
+
+    // Indexes pd by its product ID, replacing any description already
+    // indexed by the same ID.
+    void insert(BranchDescription const& pd);
+
+    cet::exempt_ptr<BranchDescription const>
+    find(ProductID const pid) const noexcept
+    {
+      if (slots_.empty()) {
+        return nullptr;
+      }
+      auto const key = pid.value();
+      for (auto i = key & mask_;; i = (i + 1) & mask_) {
+        auto const& slot = slots_[i];
+        if (slot.description == nullptr) {
+          return nullptr;
+        }
+        if (slot.key == key) {
+          return cet::make_exempt_ptr(slot.description);
+        }
+      }
+    }
+
+    std::size_t
+    size() const noexcept
+    {
+      return size_;
+    }
+
+    bool
+    empty() const noexcept
+    {
+      return size_ == 0;
+    }
+
+  private:
+    struct Slot {
+      ProductID::value_type key;
+      BranchDescription const* description;
+    };
+
+    void rehash(std::size_t n_slots);
+    void place(ProductID::value_type key, BranchDescription const* pd);
+
+    // The number of slots is zero or a power of two.
+    std::vector<Slot> slots_{};
+    ProductID::value_type mask_{};
+    std::size_t size_{};
+  };
+
+} // namespace art
+
+#endif /* canvas_Persistency_Provenance_ProductDescriptionIndex_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,185 @@
+#include "canvas/Persistency/Provenance/ProductLookupTable.h"
+// vim: set sw=2 expandtab :
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+using namespace art;
+
+namespace {
+
+  using lookup_key = std::pair<std::uintptr_t, std::uintptr_t>;
+
+  template <typename T>
+  lookup_key
+  key_of(T const& t) noexcept
+  {
+    return {t.friendlyClassName.id(), t.processName.id()};
+  }
+
+} // unnamed namespace
+
+art::ProductLookupTable::ProductLookupTable(std::vector<Row> rows)
+{
+  std::stable_sort(rows.begin(), rows.end(), [](Row const& a, Row const& b) {
+    return key_of(a) < key_of(b);
+  });
+  productIDs_.reserve(rows.size());
+  for (auto const& row : rows) {
+    if (entries_.empty() || key_of(entries_.back()) != key_of(row)) {
+      auto const pos = productIDs_.size();
+      entries_.push_back(
+        Entry{row.friendlyClassName, row.processName, pos, pos});
+    }
+    productIDs_.push_back(row.productID);
+    ++entries_.back().end;
+  }
+}
+
+void
+art::ProductLookupTable::update(std::vector<Row> rows)
+{
+  if (rows.empty()) {
+    return;
+  }
+  auto const by_key = [](Entry const& a, Entry const& b) {
+    return key_of(a) < key_of(b);
+  };
+  ProductLookupTable const replacements{std::move(rows)};
+  std::vector<Entry> added;
+  // Both sets of entries are sorted by key.
+  auto old = entries_.begin();
+  for (auto const& replacement : replacements.entries_) {
+    auto const pos = productIDs_.size();
+    auto const source = replacements.productIDs(replacement);
+    productIDs_.insert(productIDs_.end(), source.begin(), source.end());
+    Entry const entry{replacement.friendlyClassName,
+                      replacement.processName,
+                      pos,
+                      productIDs_.size()};
+    old = std::lower_bound(old, entries_.end(), entry, by_key);
+    if (old != entries_.end() && key_of(*old) == key_of(entry)) {
+      stale_ += old->end - old->begin;
+      *old = entry;
+    } else {
+      added.push_back(entry);
+    }
+  }
+  if (!added.empty()) {
+    auto const n = entries_.size();
+    entries_.insert(entries_.end(), added.cbegin(), added.cend());
+    std::inplace_merge(
+      entries_.begin(), entries_.begin() + n, entries_.end(), by_key);
+  }
+  if (stale_ > productIDs_.size() - stale_) {
+    compact();
+  }
+}
+
+void
+art::ProductLookupTable::compact()
+{
+  std::vector<ProductID> pids;
+  pids.reserve(productIDs_.size() - stale_);
+  for (auto& entry : entries_) {
+    auto const pos = pids.size();
+    auto const source = productIDs(entry);
+    pids.insert(pids.end(), source.begin(), source.end());
+    entry.begin = pos;
+    entry.end = pids.size();
+  }
+  productIDs_ = std::move(pids);
+  stale_ = 0;
+}
+
+span<ProductID const>
+art::ProductLookupTable::productIDs(InternedString const friendlyClassName,
+                                    InternedString const processName) const
+{
+  lookup_key const key{friendlyClassName.id(), processName.id()};
+  auto const it = std::lower_bound(
+    entries_.cbegin(), entries_.cend(), key, [](Entry const& e, lookup_key k) {
+      return key_of(e) < k;
+    });
+  if (it == entries_.cend() || key_of(*it) != key) {
+    return {};
+  }
+  return productIDs(*it);
+}
+
+span<ProductID const>
+art::ProductLookupTable::productIDs(std::string_view const friendlyClassName,
+                                    std::string_view const processName) const
+{
+  // Strings that were never interned cannot be keys of the table.
+  auto const fcn = InternedString::find(friendlyClassName);
+  if (!fcn) {
+    return {};
+  }
+  auto const process = InternedString::find(processName);
+  if (!process) {
+    return {};
+  }
+  return productIDs(*fcn, *process);
+}
+
+span<ProductID const>
+art::ProductLookupTable::productIDs(Entry const& entry) const
+{
+  return {productIDs_.data() + entry.begin, entry.end - entry.begin};
+}
+
+span<ProductLookupTable::Entry const>
+art::ProductLookupTable::entries(InternedString const friendlyClassName) const
+{
+  auto const id = friendlyClassName.id();
+  auto const b = std::lower_bound(
+    entries_.data(),
+    entries_.data() + entries_.size(),
+    id,
+    [](Entry const& entry, std::uintptr_t const k) {
+      return entry.friendlyClassName.id() < k;
+    });
+  auto const e = std::upper_bound(
+    b,
+    entries_.data() + entries_.size(),
+    id,
+    [](std::uintptr_t const k, Entry const& entry) {
+      return k < entry.friendlyClassName.id();
+    });
+  return {b, e};
+}
+
+span<ProductLookupTable::Entry const>
+art::ProductLookupTable::entries(std::string_view const friendlyClassName) const
+{
+  auto const fcn = InternedString::find(friendlyClassName);
+  if (!fcn) {
+    return {};
+  }
+  return entries(*fcn);
+}
+
+ProductLookup_t
+art::ProductLookupTable::toMap() const
+{
+  ProductLookup_t result;
+  for (auto const& entry : entries_) {
+    auto const pids = productIDs(entry);
+    result[entry.friendlyClassName.str()][entry.processName.str()].assign(
+      pids.begin(), pids.end());
+  }
+  return result;
+}
+
+ProcessLookup
+art::ProductLookupTable::byProcess(InternedString const friendlyClassName) const
+{
+  ProcessLookup result;
+  for (auto const& entry : entries(friendlyClassName)) {
+    auto const pids = productIDs(entry);
+    result[entry.processName.str()].assign(pids.begin(), pids.end());
+  }
+  return result;
+}
@@ -0,0 +1,111 @@
+#ifndef canvas_Persistency_Provenance_ProductLookupTable_h
+#define canvas_Persistency_Provenance_ProductLookupTable_h
+// vim: set sw=2 expandtab :
+
+////////////////////////////////////////////////////////////////////////
+//
+// ProductLookupTable: the IDs of products keyed by friendly class name
+// and process name, in a flat table.
+//
+// The keys are interned strings (see InternedString.h), and the table
+// is sorted by their ids, so that a lookup is a binary search over
+// pairs of integers.  The IDs of the products for each key are stored
+// contiguously, in the order in which they were supplied, and are
+// returned as a span.
+//
+// The table of the products that support views is keyed by process
+// name only: its friendly class names are empty.
+//
+// The table may be updated key by key (see update()).  The product IDs
+// of an updated key are appended to the table and its entry is
+// retargeted to them; the entries and product IDs of the other keys
+// are left as they are.  The product IDs so superseded are discarded
+// once they outnumber the current ones, by compacting the table.
+//
+// The nested-map forms of type_aliases.h are available for
+// compatibility from toMap() and byProcess().
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Persistency/Provenance/type_aliases.h"
+#include "canvas/Utilities/InternedString.h"
+#include "canvas/Utilities/span.h"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace art {
+
+  class ProductLookupTable {
+  public:
+    struct Key {
+      InternedString friendlyClassName;
+      InternedString processName;
+    };
+
+    struct Row {
+      InternedString friendlyClassName;
+      InternedString processName;
+      ProductID productID;
+    };
+
+    struct Entry {
+      InternedString friendlyClassName;
+      InternedString processName;
+      // Positions of the entry's product IDs in the table.
+      std::size_t begin;
+      std::size_t end;
+    };
+
+    ProductLookupTable() = default;
+    explicit ProductLookupTable(std::vector<Row> rows);
+
+    // Replaces the product IDs of each key present in rows by those of
+    // rows, adding the keys not already in the table.  No string is
+    // compared.  Spans previously returned by the table are invalidated.
+    void update(std::vector<Row> rows);
+
+    span<ProductID const> productIDs(InternedString friendlyClassName,
+                                     InternedString processName) const;
+    span<ProductID const> productIDs(std::string_view friendlyClassName,
+                                     std::string_view processName) const;
+    span<ProductID const> productIDs(Entry const& entry) const;
+
+    // The entries for the given friendly class name, one per process
+    // name, in unspecified order.
+    span<Entry const> entries(InternedString friendlyClassName) const;
+    span<Entry const> entries(std::string_view friendlyClassName) const;
+
+    span<Entry const>
+    entries() const noexcept
+    {
+      return {entries_.data(), entries_.size()};
+    }
+
+    bool
+    empty() const noexcept
+    {
+      return entries_.empty();
+    }
+
+    ProductLookup_t toMap() const;
+    ProcessLookup byProcess(InternedString friendlyClassName = {}) const;
+
+  private:
+    void compact();
+
+    std::vector<Entry> entries_{};
+    std::vector<ProductID> productIDs_{};
+    // The number of product IDs no longer referred to by any entry.
+    std::size_t stale_{};
+  };
+
+} // namespace art
+
+#endif /* canvas_Persistency_Provenance_ProductLookupTable_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -5,55 +5,84 @@
 #include "canvas/Persistency/Provenance/detail/createProductLookups.h"
 #include "canvas/Persistency/Provenance/detail/createViewLookups.h"
 
+#include "tbb/parallel_for.h"
+
 #include <array>
+#include <memory>
+#include <vector>
 
 using namespace art;
 
-namespace {
+art::ProductTable::ProductTable(ProductDescriptions const& descs,
+                                BranchType const bt)
+  : isValid{true}
+{
+  add(descs, bt);
+}
 
-  auto
-  descriptions_for_branch_type(BranchType const bt,
-                               ProductDescriptions const& descriptions)
-  {
-    ProductDescriptionsByID result;
-    for (auto const& pd : descriptions) {
-      if (pd.branchType() != bt) {
-        continue;
-      }
-      result.try_emplace(pd.productID(), pd);
-    }
-    return result;
-  }
+art::ProductTable::ProductTable(ProductTable const& other)
+  : isValid{other.isValid}
+  , descriptions{other.descriptions}
+  , descriptionIndex{descriptions}
+  , coreDescriptions{other.coreDescriptions}
+  , productLookupTable{other.productLookupTable}
+  , viewLookupTable{other.viewLookupTable}
+  , productLookup{other.productLookup}
+  , viewLookup{other.viewLookup}
+{}
 
-  using ProductTables_t = std::array<ProductTable, NumBranchTypes>;
+art::ProductTable&
+art::ProductTable::operator=(ProductTable const& other)
+{
+  return *this = ProductTable{other};
+}
 
-  auto
-  createProductTables(ProductDescriptions const& descriptions)
-  {
-    ProductTables_t result{{}};
-    for (std::size_t bt{}; bt < NumBranchTypes; ++bt) {
-      result[bt] = ProductTable{descriptions, static_cast<BranchType>(bt)};
+void
+art::ProductTable::add(ProductDescriptions const& descs, BranchType const bt)
+{
+  isValid = true;
+  std::vector<ProductID> added;
+  for (auto const& pd : descs) {
+    if (pd.branchType() != bt) {
+      continue;
+    }
+    if (auto [it, inserted] = descriptions.try_emplace(pd.productID(), pd);
+        inserted) {
+      descriptionIndex.insert(it->second);
+      coreDescriptions.try_emplace(
+        pd.productID(), std::make_shared<ProductDescription const>(pd));
+      added.push_back(pd.productID());
     }
-    return result;
+  }
+  if (added.empty()) {
+    return;
   }
 
-} // unnamed namespace
-
-art::ProductTable::ProductTable(ProductDescriptions const& descs,
-                                BranchType const bt)
-  : isValid{true}
-  , descriptions{descriptions_for_branch_type(bt, descs)}
-  , productLookup{detail::createProductLookups(descriptions)}
-  , viewLookup{detail::createViewLookups(descriptions)}
-{}
+  for (auto const& [fcn, process] :
+       detail::addProductLookups(productLookupTable, coreDescriptions, added)) {
+    auto const pids = productLookupTable.productIDs(fcn, process);
+    productLookup[fcn.str()][process.str()].assign(pids.begin(), pids.end());
+  }
+  for (auto const& [fcn, process] :
+       detail::addViewLookups(viewLookupTable, coreDescriptions, added)) {
+    auto const pids = viewLookupTable.productIDs(fcn, process);
+    viewLookup[process.str()].assign(pids.begin(), pids.end());
+  }
+}
 
 cet::exempt_ptr<art::BranchDescription const>
 art::ProductTable::description(ProductID const pid) const
 {
-  if (auto it = descriptions.find(pid); it != cend(descriptions)) {
-    return cet::make_exempt_ptr(&it->second);
-  }
-  return nullptr;
+  return descriptionIndex.find(pid);
+}
+
+cet::exempt_ptr<art::ProductDescription const>
+art::ProductTable::coreDescription(ProductID const pid) const
+{
+  auto const it = coreDescriptions.find(pid);
+  return it == coreDescriptions.cend() ?
+           nullptr :
+           cet::make_exempt_ptr(it->second.get());
 }
 
 art::ProductTables
@@ -63,5 +92,14 @@ art::ProductTables::invalid()
 }
 
 art::ProductTables::ProductTables(ProductDescriptions const& descriptions)
-  : tables_{createProductTables(descriptions)}
-{}
+{
+  add(descriptions);
+}
+
+void
+art::ProductTables::add(ProductDescriptions const& descriptions)
+{
+  tbb::parallel_for(std::size_t{}, std::size_t{NumBranchTypes}, [&](auto bt) {
+    tables_[bt].add(descriptions, static_cast<BranchType>(bt));
+  });
+}
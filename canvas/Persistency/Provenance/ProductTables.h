@@ -4,6 +4,9 @@
 
 #include "canvas/Persistency/Provenance/BranchDescription.h"
 #include "canvas/Persistency/Provenance/BranchType.h"
+#include "canvas/Persistency/Provenance/ProductDescription.h"
+#include "canvas/Persistency/Provenance/ProductDescriptionIndex.h"
+#include "canvas/Persistency/Provenance/ProductLookupTable.h"
 #include "canvas/Persistency/Provenance/fwd.h"
 #include "canvas/Persistency/Provenance/type_aliases.h"
 #include "cetlib/exempt_ptr.h"
@@ -22,9 +25,35 @@ namespace art {
     explicit ProductTable(ProductDescriptions const& descriptions,
                           BranchType bt);
 
+    // The description index refers to the elements of descriptions, and
+    // is rebuilt for those of the copy.
+    ProductTable(ProductTable const& other);
+    ProductTable(ProductTable&&) = default;
+    ProductTable& operator=(ProductTable const& other);
+    ProductTable& operator=(ProductTable&&) = default;
+
+    // Adds those of the descriptions of branch type bt whose products
+    // are not already in the table.  Only the lookups of the keys of
+    // the added products are recomputed.
+    void add(ProductDescriptions const& descriptions, BranchType bt);
+
     cet::exempt_ptr<BranchDescription const> description(ProductID) const;
+    cet::exempt_ptr<ProductDescription const> coreDescription(
+      ProductID) const;
     bool isValid{false};
     ProductDescriptionsByID descriptions{};
+    ProductDescriptionIndex descriptionIndex{};
+
+    // The interned cores of the descriptions, from which the lookups
+    // are built.  They are shared with the copies of the table.
+    CoreDescriptionsByID coreDescriptions{};
+
+    // The IDs of the products by friendly class name and process name,
+    // and of those that support views by process name.
+    ProductLookupTable productLookupTable{};
+    ProductLookupTable viewLookupTable{};
+
+    // The same lookups in their nested-map forms, for compatibility.
     ProductLookup_t productLookup{};
     ViewLookup_t viewLookup{};
   };
@@ -39,6 +68,11 @@ namespace art {
   public:
     static ProductTables invalid();
 
+    // Adds the descriptions whose products are not already in the
+    // tables.  The tables of the different branch types are updated
+    // concurrently.
+    void add(ProductDescriptions const& descriptions);
+
     auto const&
     descriptions(BranchType const bt) const
     {
@@ -11,7 +11,10 @@
 #include "cetlib/crc32.h"
 
 #include <algorithm>
+#include <charconv>
 #include <cstddef>
+#include <optional>
+#include <type_traits>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -39,6 +42,89 @@ namespace art {
       return true;
     }
 
+    // The range starting at it, merged with any adjacent ranges that
+    // follow it, as RangeSet::collapse() would do.
+    EventRange
+    next_collapsed(vector<EventRange>::const_iterator& it,
+                   vector<EventRange>::const_iterator const end)
+    {
+      EventRange result{*it++};
+      while (it != end && result.is_adjacent(*it)) {
+        result.merge(*it++);
+      }
+      return result;
+    }
+
+    // Equivalent to calling disjoint() on the result of merging the
+    // collapsed forms of the two sorted vectors, without forming either
+    // the collapsed or the merged vectors.
+    bool
+    disjoint(vector<EventRange> const& l, vector<EventRange> const& r)
+    {
+      auto il = l.cbegin();
+      auto ir = r.cbegin();
+      auto const el = l.cend();
+      auto const er = r.cend();
+      optional<EventRange> lnext;
+      optional<EventRange> rnext;
+      optional<EventRange> prev;
+      while (true) {
+        if (!lnext && il != el) {
+          lnext = next_collapsed(il, el);
+        }
+        if (!rnext && ir != er) {
+          rnext = next_collapsed(ir, er);
+        }
+        if (!lnext && !rnext) {
+          return true;
+        }
+        bool const takeLeft = !rnext || (lnext && !(*rnext < *lnext));
+        auto& current = takeLeft ? lnext : rnext;
+        if (prev && !prev->is_disjoint(*current)) {
+          return false;
+        }
+        prev = current;
+        current.reset();
+      }
+    }
+
+    // The bytes fed to the checksum are those of to_compact_string().
+    void
+    add_number(cet::crc32& crc, unsigned long long const n)
+    {
+      char buffer[24];
+      auto const result = to_chars(begin(buffer), end(buffer), n);
+      crc.process_bytes(buffer, result.ptr - buffer);
+    }
+
+    void
+    add_char(cet::crc32& crc, char const c)
+    {
+      crc.process_bytes(&c, 1);
+    }
+
+    void
+    add_range(cet::crc32& crc, EventRange const& r)
+    {
+      add_number(crc, r.subRun());
+      add_char(crc, '[');
+      add_number(crc, r.begin());
+      add_char(crc, ',');
+      add_number(crc, r.end());
+      add_char(crc, ')');
+    }
+
+    vector<EventRange> const&
+    sorted_ranges(RangeSet const& rs, vector<EventRange>& buffer)
+    {
+      if (rs.is_sorted()) {
+        return rs.ranges();
+      }
+      buffer = rs.ranges();
+      cet::sort_all(buffer);
+      return buffer;
+    }
+
   } // unnamed namespace
 
   RangeSet
@@ -59,14 +145,58 @@ namespace art {
     return RangeSet{srid.run(), {EventRange::forSubRun(srid.subRun())}};
   }
 
-  // The special member functions cannot be noexcept because ranges_
-  // is a vector.
+  static_assert(std::is_trivially_copyable_v<cet::crc32>,
+                "The checksum cache of RangeSet must be trivially copyable.");
+
+  // The special member functions are defined because checksumCache_
+  // is atomic.  They cannot be noexcept because ranges_ is a vector.
   RangeSet::~RangeSet() = default;
   RangeSet::RangeSet() = default;
-  RangeSet::RangeSet(RangeSet const& rhs) = default;
-  RangeSet::RangeSet(RangeSet&& rhs) = default;
-  RangeSet& RangeSet::operator=(RangeSet const& rhs) = default;
-  RangeSet& RangeSet::operator=(RangeSet&& rhs) = default;
+
+  RangeSet::RangeSet(RangeSet const& rhs)
+    : run_{rhs.run_}
+    , ranges_{rhs.ranges_}
+    , isCollapsed_{rhs.isCollapsed_}
+    , sorted_{rhs.sorted_}
+    , checksumCache_{rhs.checksumCache_.load(memory_order_relaxed)}
+  {}
+
+  RangeSet::RangeSet(RangeSet&& rhs)
+    : run_{rhs.run_}
+    , ranges_{std::move(rhs.ranges_)}
+    , isCollapsed_{rhs.isCollapsed_}
+    , sorted_{rhs.sorted_}
+    , checksumCache_{rhs.checksumCache_.load(memory_order_relaxed)}
+  {
+    rhs.reset_checksum();
+  }
+
+  RangeSet&
+  RangeSet::operator=(RangeSet const& rhs)
+  {
+    if (this != &rhs) {
+      run_ = rhs.run_;
+      ranges_ = rhs.ranges_;
+      isCollapsed_ = rhs.isCollapsed_;
+      sorted_ = rhs.sorted_;
+      checksumCache_.store(rhs.checksumCache_.load(memory_order_relaxed),
+                           memory_order_relaxed);
+    }
+    return *this;
+  }
+
+  RangeSet&
+  RangeSet::operator=(RangeSet&& rhs)
+  {
+    run_ = rhs.run_;
+    ranges_ = std::move(rhs.ranges_);
+    isCollapsed_ = rhs.isCollapsed_;
+    sorted_ = rhs.sorted_;
+    checksumCache_.store(rhs.checksumCache_.load(memory_order_relaxed),
+                         memory_order_relaxed);
+    rhs.reset_checksum();
+    return *this;
+  }
 
   RangeSet::RangeSet(RunNumber_t const r) : RangeSet{r, {}} {}
 
@@ -105,12 +235,7 @@ namespace art {
     if (run_ != r) {
       return false;
     }
-    for (auto const& range : ranges_) {
-      if (range.contains(s, e)) {
-        return true;
-      }
-    }
-    return false;
+    return find_range(s, e) != ranges_.cend();
   }
 
   bool
@@ -212,8 +337,37 @@ namespace art {
   unsigned
   RangeSet::checksum() const
   {
-    // Could cache checksums to improve performance when necessary.
-    return checksum_ = cet::crc32{to_compact_string()}.digest();
+    if (ranges_.empty()) {
+      cet::crc32 crc;
+      add_number(crc, run_);
+      return crc.digest();
+    }
+    // The last range is never folded into the cached prefix, as
+    // update() may extend it.
+    // The cache holds no other data than its own, so that relaxed
+    // ordering suffices.
+    auto const last = ranges_.size() - 1;
+    auto const cache = checksumCache_.load(memory_order_relaxed);
+    auto crc = cache.prefix;
+    size_t n = cache.ranges;
+    if (n == noChecksum_ || n > last) {
+      crc = cet::crc32{};
+      add_number(crc, run_);
+      add_char(crc, ':');
+      n = 0;
+    }
+    if (n != last) {
+      for (auto i = n; i != last; ++i) {
+        add_range(crc, ranges_[i]);
+      }
+      // Concurrent calls publish the same prefix.
+      if (last < noChecksum_) {
+        checksumCache_.store({crc, static_cast<uint32_t>(last)},
+                             memory_order_relaxed);
+      }
+    }
+    add_range(crc, ranges_.back());
+    return crc.digest();
   }
 
   size_t
@@ -223,6 +377,13 @@ namespace art {
       return end_idx();
     }
     auto const sr = ranges_.at(b).subRun();
+    if (sorted_) {
+      auto const pos = partition_point(
+        ranges_.cbegin() + b, ranges_.cend(), [sr](auto const& range) {
+          return range.subRun() == sr;
+        });
+      return static_cast<size_t>(pos - ranges_.cbegin());
+    }
     auto pos =
       find_if(ranges_.cbegin() + b, ranges_.cend(), [sr](auto const& range) {
         return range.subRun() != sr;
@@ -233,18 +394,23 @@ namespace art {
   EventRange&
   RangeSet::front()
   {
+    reset_checksum_from(0);
+    sorted_ = false;
     return ranges_.front();
   }
 
   EventRange&
   RangeSet::back()
   {
+    sorted_ = false;
     return ranges_.back();
   }
 
   EventRange&
   RangeSet::at(size_t idx)
   {
+    reset_checksum_from(idx);
+    sorted_ = false;
     return ranges_.at(idx);
   }
 
@@ -266,28 +432,41 @@ namespace art {
     }
     if (ranges_.size() < 2) {
       isCollapsed_ = true;
+      sorted_ = true;
       return *this;
     }
     if (!is_sorted())
       throw art::Exception(art::errors::LogicError, "RangeSet::collapse()")
         << "A range set must be sorted before it is collapsed.\n";
 
-    auto processing = ranges_;
-    decltype(ranges_) result;
-    result.reserve(ranges_.size());
-    result.push_back(ranges_.front());
+    // Check that the ranges can be collapsed before modifying any of
+    // them, so that the RangeSet is unchanged if an exception is
+    // thrown.
+    EventRange back{ranges_.front()};
     for (auto ir = ranges_.cbegin() + 1, e = ranges_.cend(); ir != e; ++ir) {
       auto const& r = *ir;
-      auto& back = result.back();
       if (back.is_adjacent(r)) {
         back.merge(r);
       } else {
         throw_if_not_disjoint(run_, back, r);
-        result.push_back(r);
+        back = r;
+      }
+    }
+    auto out = ranges_.begin();
+    auto firstChanged = ranges_.size();
+    for (auto ir = out + 1, e = ranges_.end(); ir != e; ++ir) {
+      if (out->is_adjacent(*ir)) {
+        firstChanged =
+          std::min(firstChanged, static_cast<size_t>(out - ranges_.begin()));
+        out->merge(*ir);
+      } else {
+        *++out = *ir;
       }
     }
-    std::swap(ranges_, result);
+    ranges_.erase(out + 1, ranges_.end());
+    reset_checksum_from(firstChanged);
     isCollapsed_ = true;
+    sorted_ = true;
     return *this;
   }
 
@@ -299,16 +478,27 @@ namespace art {
     }
     if (!is_valid()) {
       run_ = other.run();
+      reset_checksum();
     }
-    vector<EventRange> merged;
-    std::merge(ranges_.cbegin(),
-               ranges_.cend(),
-               other.ranges_.cbegin(),
-               other.ranges_.cend(),
-               back_inserter(merged));
-    unique(merged.begin(), merged.end());
-    std::swap(ranges_, merged);
+    if (&other == this) {
+      return merge(RangeSet{other});
+    }
+    // Merge from the back, so that no element is overwritten before it
+    // has been moved to its final position.
+    auto const& src = other.ranges_;
+    auto i = ranges_.size();
+    auto j = src.size();
+    ranges_.resize(i + j);
+    for (auto k = ranges_.size(); j != 0;) {
+      if (i != 0 && src[j - 1] < ranges_[i - 1]) {
+        ranges_[--k] = ranges_[--i];
+      } else {
+        ranges_[--k] = src[--j];
+      }
+    }
+    reset_checksum_from(i);
     isCollapsed_ = false;
+    sorted_ = false;
     collapse();
     return *this;
   }
@@ -319,6 +509,9 @@ namespace art {
     require_not_full_run();
     if (!rs.ranges_.empty() && (e >= 1) && (e <= rs.ranges_.size())) {
       ranges_.assign(rs.ranges_.cbegin() + b, rs.ranges_.cbegin() + e);
+      // A part of sorted, disjoint ranges is sorted and disjoint.
+      sorted_ = rs.sorted_;
+      reset_checksum();
     }
   }
 
@@ -329,13 +522,17 @@ namespace art {
     if (ranges_.empty()) {
       run_ = id.run();
       ranges_.emplace_back(id.subRun(), id.event(), id.next().event());
+      sorted_ = true;
+      reset_checksum();
       return;
     }
     auto& back = ranges_.back();
     if (back.subRun() == id.subRun() && back.end() == id.event()) {
       back.set_end(id.next().event());
     } else {
-      ranges_.emplace_back(id.subRun(), id.event(), id.next().event());
+      EventRange range{id.subRun(), id.event(), id.next().event()};
+      sorted_ = sorted_ && back < range && back.is_disjoint(range);
+      ranges_.push_back(range);
     }
   }
 
@@ -347,10 +544,7 @@ namespace art {
     require_not_full_run();
     bool did_split = false;
     auto result = ranges_.end();
-    auto foundRange =
-      find_if(ranges_.cbegin(), ranges_.cend(), [s, e](auto const& r) {
-        return r.contains(s, e);
-      });
+    auto foundRange = find_range(s, e);
     // Split only if:
     // - the range is found (i.e. the event is contained by the found range)
     // - the range is valid
@@ -359,6 +553,7 @@ namespace art {
         (foundRange->size() > 1ull)) {
       auto const begin = foundRange->begin();
       auto const end = foundRange->end();
+      reset_checksum_from(foundRange - ranges_.cbegin());
       auto leftIt = ranges_.emplace(foundRange, s, begin, e);
       result = next(leftIt);
       EventRange right{s, e, end};
@@ -372,18 +567,59 @@ namespace art {
   RangeSet::set_run(RunNumber_t const r)
   {
     run_ = r;
+    reset_checksum();
   }
 
   void
   RangeSet::sort()
   {
     cet::sort_all(ranges_);
+    reset_checksum();
   }
 
   void
   RangeSet::clear()
   {
     ranges_.clear();
+    sorted_ = true;
+    reset_checksum();
+  }
+
+  RangeSet::const_iterator
+  RangeSet::find_range(SubRunNumber_t const s, EventNumber_t const e) const
+  {
+    if (!sorted_) {
+      return find_if(ranges_.cbegin(), ranges_.cend(), [s, e](auto const& r) {
+        return r.contains(s, e);
+      });
+    }
+    // The ranges are sorted and disjoint: only the last range that
+    // begins at or before (s, e) can contain it.
+    auto it = upper_bound(ranges_.cbegin(),
+                          ranges_.cend(),
+                          make_pair(s, e),
+                          [](auto const& id, EventRange const& r) {
+                            return id < make_pair(r.subRun(), r.begin());
+                          });
+    if (it == ranges_.cbegin() || !prev(it)->contains(s, e)) {
+      return ranges_.cend();
+    }
+    return prev(it);
+  }
+
+  void
+  RangeSet::reset_checksum()
+  {
+    checksumCache_.store({cet::crc32{}, noChecksum_}, memory_order_relaxed);
+  }
+
+  void
+  RangeSet::reset_checksum_from(size_t const idx)
+  {
+    auto const ranges = checksumCache_.load(memory_order_relaxed).ranges;
+    if (ranges != noChecksum_ && ranges > idx) {
+      reset_checksum();
+    }
   }
 
   void
@@ -416,37 +652,21 @@ namespace art {
     if (!(l.is_valid() && r.is_valid())) {
       return false;
     }
-    if (!l.has_disjoint_ranges() || !r.has_disjoint_ranges())
-      return false;
-
-    if (l.run() != r.run())
-      return true;
-
-    // If we get here, the run numbers of both ranges are guaranteed to
-    // be the same.
-
-    // Empty RangeSets are disjoint wrt. other RangeSets.  Must handle
-    // this case separately than l == r case.
-    if (l.empty() || r.empty())
-      return true;
+    if (l.run() != r.run() || l.empty() || r.empty()) {
+      // Empty RangeSets are disjoint wrt. other RangeSets.
+      return l.has_disjoint_ranges() && r.has_disjoint_ranges();
+    }
 
-    // If we get this far, then neither RangeSet is empty.
+    // If we get this far, then neither RangeSet is empty, and the run
+    // numbers of both ranges are the same.
     if (l == r)
       return false;
 
-    RangeSet ltmp{l};
-    RangeSet rtmp{r};
-    auto const& lranges = ltmp.collapse().ranges();
-    auto const& rranges = rtmp.collapse().ranges();
-
-    std::vector<EventRange> merged;
-    std::merge(lranges.begin(),
-               lranges.end(),
-               rranges.begin(),
-               rranges.end(),
-               back_inserter(merged));
-
-    return disjoint(merged);
+    // A single pass over the ranges of both RangeSets, in sorted
+    // order, detects overlaps within as well as between them.
+    vector<EventRange> lbuffer;
+    vector<EventRange> rbuffer;
+    return disjoint(sorted_ranges(l, lbuffer), sorted_ranges(r, rbuffer));
   }
 
   void
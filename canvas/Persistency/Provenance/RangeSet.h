@@ -6,8 +6,11 @@
 #include "canvas/Persistency/Provenance/IDNumber.h"
 #include "canvas/Persistency/Provenance/fwd.h"
 #include "canvas/Utilities/Level.h"
+#include "cetlib/crc32.h"
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <ostream>
 #include <string>
@@ -105,14 +108,52 @@ namespace art {
   private:
     explicit RangeSet();
 
+    // The range containing the event, or end() if there is none.  The
+    // search is a binary one if the ranges are known to be sorted and
+    // disjoint (see sorted_).
+    const_iterator find_range(SubRunNumber_t, EventNumber_t) const;
     void require_not_full_run();
 
+    // Discard the cached checksum state if the run number or any of the
+    // ranges at or after the given index have changed.
+    void reset_checksum();
+    void reset_checksum_from(std::size_t idx);
+
     RunNumber_t run_{IDNumber<Level::Run>::invalid()};
     std::vector<EventRange> ranges_{};
 
     // Auxiliary info
     bool isCollapsed_{false};
+
+    // Persisted, but no longer written: the checksum is computed from
+    // run_ and ranges_ (see checksumCache_), and this member is never
+    // read back.  It is kept so that the layout of the class does not
+    // change.
     mutable unsigned checksum_{invalidChecksum()};
+
+    // Whether the ranges are known to be sorted and disjoint, so that
+    // they may be searched by bisection.  Unlike isCollapsed_, which
+    // only records that collapse() has been called, it is cleared by
+    // any modification that may break that order.  A RangeSet filled
+    // by ROOT starts without it.
+    bool sorted_{false}; //! transient
+
+    // The checksum is the crc32 of to_compact_string().  The crc32 of
+    // its prefix, up to and excluding the range at index 'ranges', is
+    // cached so that it need not be recomputed when ranges are
+    // appended or the last range is extended.  As checksum() may be
+    // called concurrently, the two are held in a single atomic object,
+    // which is read and replaced as a whole.  A RangeSet filled by
+    // ROOT is default-constructed, with an empty cache.
+    struct ChecksumCache {
+      cet::crc32 prefix;
+      std::uint32_t ranges;
+    };
+    static_assert(std::atomic<ChecksumCache>::is_always_lock_free);
+    static constexpr std::uint32_t noChecksum_{
+      std::numeric_limits<std::uint32_t>::max()};
+    mutable std::atomic<ChecksumCache> checksumCache_{
+      ChecksumCache{cet::crc32{}, noChecksum_}}; //! transient
   };
 
   template <typename... ARGS>
@@ -122,6 +163,7 @@ namespace art {
     require_not_full_run();
     ranges_.emplace_back(std::forward<ARGS>(args)...);
     isCollapsed_ = false;
+    sorted_ = false;
   }
 
   bool operator==(RangeSet const& l, RangeSet const& r);
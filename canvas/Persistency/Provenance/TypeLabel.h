@@ -12,10 +12,12 @@
 //================================================================
 
 #include "canvas/Utilities/TypeID.h"
+#include "canvas/Utilities/static_type_name.h"
 
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <utility>
 
 namespace art {
 
@@ -30,6 +32,20 @@ namespace art {
               std::string const& instanceName,
               bool const supportsView,
               std::string emulatedModule);
+
+    // For a type known at compile time, the class names are obtained
+    // from static_type_name<T>() and static_friendly_name<T>().
+    template <typename T>
+    TypeLabel(std::in_place_type_t<T>,
+              std::string const& instanceName,
+              bool const supportsView,
+              bool const transient = false);
+
+    template <typename T>
+    TypeLabel(std::in_place_type_t<T>,
+              std::string const& instanceName,
+              bool const supportsView,
+              std::string emulatedModule);
     ~TypeLabel();
 
     auto const&
@@ -37,15 +53,16 @@ namespace art {
     {
       return typeID_;
     }
-    std::string
+    std::string const&
     className() const
     {
-      return typeID_.className();
+      return className_ ? *className_ : typeID_.className();
     }
     std::string
     friendlyClassName() const
     {
-      return typeID_.friendlyClassName();
+      return friendlyClassName_ ? *friendlyClassName_ :
+                                  typeID_.friendlyClassName();
     }
     std::string const& emulatedModule() const;
     std::string const&
@@ -71,6 +88,9 @@ namespace art {
 
   private:
     TypeID typeID_;
+    // Set only for types known at compile time.
+    std::string const* className_{nullptr};
+    std::string const* friendlyClassName_{nullptr};
     std::string productInstanceName_;
     bool supportsView_;
     bool transient_{false};
@@ -83,6 +103,31 @@ namespace art {
   bool operator<(TypeLabel const& a, TypeLabel const& b);
   std::ostream& operator<<(std::ostream& os, TypeLabel const& tl);
 
+  template <typename T>
+  TypeLabel::TypeLabel(std::in_place_type_t<T>,
+                       std::string const& instanceName,
+                       bool const supportsView,
+                       bool const transient /* = false */)
+    : TypeLabel{TypeID{typeid(T)}, instanceName, supportsView, transient}
+  {
+    className_ = &static_type_name<T>();
+    friendlyClassName_ = &static_friendly_name<T>();
+  }
+
+  template <typename T>
+  TypeLabel::TypeLabel(std::in_place_type_t<T>,
+                       std::string const& instanceName,
+                       bool const supportsView,
+                       std::string emulatedModule)
+    : TypeLabel{TypeID{typeid(T)},
+                instanceName,
+                supportsView,
+                std::move(emulatedModule)}
+  {
+    className_ = &static_type_name<T>();
+    friendlyClassName_ = &static_friendly_name<T>();
+  }
+
 } // namespace art
 
 #endif /* canvas_Persistency_Provenance_TypeLabel_h */
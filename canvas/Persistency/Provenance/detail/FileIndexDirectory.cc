@@ -0,0 +1,330 @@
+#include "canvas/Persistency/Provenance/detail/FileIndexDirectory.h"
+// vim: set sw=2 expandtab :
+
+#include "canvas/Persistency/Provenance/RunID.h"
+#include "canvas/Persistency/Provenance/SubRunID.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+  constexpr std::uint32_t
+  sortKey(std::uint32_t const n) noexcept
+  {
+    // Maps the invalid value (-1) to zero, preserving the order of all
+    // other values.
+    return n + 1u;
+  }
+
+  std::uint64_t
+  groupKey(art::RunNumber_t const r, art::SubRunNumber_t const sr) noexcept
+  {
+    return (static_cast<std::uint64_t>(sortKey(r)) << 32) | sortKey(sr);
+  }
+
+  std::uint64_t
+  groupKey(art::SubRunID const& srID) noexcept
+  {
+    return groupKey(srID.run(), srID.subRun());
+  }
+
+  constexpr bool
+  hasValidSubRun(std::uint64_t const key) noexcept
+  {
+    return (key >> 32) != 0u && (key & 0xFFFFFFFFu) != 0u;
+  }
+
+  // Lower bound in [first, last), probing at exponentially increasing
+  // distances from first before bisecting: O(log d), where d is the
+  // distance from first to the result.
+  template <typename It, typename T, typename Less>
+  It
+  gallop_lower_bound(It first, It const last, T const& value, Less less)
+  {
+    if (first == last || !less(*first, value)) {
+      return first;
+    }
+    // Invariant: *first < value.
+    for (std::ptrdiff_t step = 1;; step *= 2) {
+      if (step >= last - first) {
+        return std::lower_bound(first + 1, last, value, less);
+      }
+      auto const probe = first + step;
+      if (!less(*probe, value)) {
+        return std::lower_bound(first + 1, probe, value, less);
+      }
+      first = probe;
+    }
+  }
+
+} // unnamed namespace
+
+namespace art::detail {
+
+  FileIndexDirectory::FileIndexDirectory(
+    std::vector<FileIndex::Element> const& entries)
+  {
+    auto const n = entries.size();
+    events_.reserve(n);
+    for (std::size_t i = 0; i != n; ++i) {
+      auto const& id = entries[i].eventID;
+      events_.push_back(sortKey(id.event()));
+      auto const key = groupKey(id.subRunID());
+      if (groups_.empty() || groups_.back().key != key) {
+        if (!groups_.empty()) {
+          groups_.back().end = i;
+        }
+        groups_.push_back(Group{key, i, n, n, n, n, n});
+      }
+    }
+
+    // Within a group with a valid subrun, the subrun entries (invalid
+    // event number, sort key 0) precede the events.
+    for (auto& g : groups_) {
+      if (hasValidSubRun(g.key)) {
+        auto const b = cbegin(events_) + g.begin;
+        auto const e = cbegin(events_) + g.end;
+        g.eventsBegin = std::upper_bound(b, e, 0u) - cbegin(events_);
+      } else {
+        g.eventsBegin = g.end;
+      }
+    }
+
+    // Record, for each group, the first entry of each type at or after
+    // the start of that group.
+    std::size_t nextRun{n}, nextSubRun{n}, nextEvent{n};
+    for (auto it = rbegin(groups_), e = rend(groups_); it != e; ++it) {
+      if (hasValidSubRun(it->key)) {
+        if (it->eventsBegin != it->end) {
+          nextEvent = it->eventsBegin;
+        }
+        if (it->begin != it->eventsBegin) {
+          nextSubRun = it->begin;
+        }
+      } else {
+        nextRun = it->begin;
+      }
+      it->nextRun = nextRun;
+      it->nextSubRun = nextSubRun;
+      it->nextEvent = nextEvent;
+    }
+
+    groupForKey_.reserve(groups_.size());
+    for (std::size_t i = 0, sz = groups_.size(); i != sz; ++i) {
+      groupForKey_.emplace(groups_[i].key, i);
+    }
+  }
+
+  std::size_t
+  FileIndexDirectory::size() const noexcept
+  {
+    return events_.size();
+  }
+
+  std::size_t
+  FileIndexDirectory::lowerBound(EventID const& eID) const
+  {
+    return lowerBound_(eID).pos;
+  }
+
+  std::size_t
+  FileIndexDirectory::findEvent(EventID const& eID, bool const exact) const
+  {
+    if (!exact) {
+      return firstEventAtOrAfter_(lowerBound_(eID));
+    }
+    auto const eventKey = sortKey(eID.event());
+    auto const key = groupKey(eID.subRunID());
+    if (eventKey == 0u || !hasValidSubRun(key)) {
+      return size();
+    }
+    auto const g = exactGroup_(key);
+    if (g == nullptr) {
+      return size();
+    }
+    auto const pos = lowerBoundEvent_(*g, eventKey);
+    return (pos != g->end && events_[pos] == eventKey) ? pos : size();
+  }
+
+  std::vector<std::size_t>
+  FileIndexDirectory::findEvents(std::vector<EventID> const& eIDs,
+                                 bool const exact) const
+  {
+    auto const group_less = [](Group const& g, std::uint64_t const k) {
+      return g.key < k;
+    };
+    std::vector<std::size_t> result;
+    result.reserve(eIDs.size());
+    auto group = cbegin(groups_);
+    auto const groups_end = cend(groups_);
+    // Lower bound of the previous ID within *group.
+    std::size_t pos{};
+    for (auto const& eID : eIDs) {
+      auto const key = groupKey(eID.subRunID());
+      auto const eventKey = sortKey(eID.event());
+      auto const next = gallop_lower_bound(group, groups_end, key, group_less);
+      if (next != group) {
+        group = next;
+        pos = group == groups_end ? size() : group->begin;
+      }
+      std::size_t const index = group - cbegin(groups_);
+      bool const found_group = group != groups_end && group->key == key;
+      if (found_group) {
+        auto const events_begin = cbegin(events_);
+        pos = gallop_lower_bound(events_begin + pos,
+                                 events_begin + group->end,
+                                 eventKey,
+                                 std::less<>{}) -
+              events_begin;
+      }
+      if (exact) {
+        bool const match = found_group && eventKey != 0u &&
+                           hasValidSubRun(key) && pos != group->end &&
+                           events_[pos] == eventKey;
+        result.push_back(match ? pos : size());
+        continue;
+      }
+      auto const c = (found_group && pos == group->end) ?
+                       atGroup_(index + 1) :
+                       Cursor{index, pos};
+      result.push_back(firstEventAtOrAfter_(c));
+    }
+    return result;
+  }
+
+  std::size_t
+  FileIndexDirectory::findSubRun(SubRunID const& srID, bool const exact) const
+  {
+    auto const key = groupKey(srID);
+    if (!exact) {
+      return firstSubRunAtOrAfter_(lowerBound_(key));
+    }
+    auto const g = exactGroup_(key);
+    if (g == nullptr || !hasValidSubRun(key) || g->begin == g->eventsBegin) {
+      return size();
+    }
+    return g->begin;
+  }
+
+  std::size_t
+  FileIndexDirectory::findRun(RunID const& rID, bool const exact) const
+  {
+    auto const key = groupKey(rID.run(), IDNumber<Level::SubRun>::invalid());
+    if (!exact) {
+      return firstRunAtOrAfter_(lowerBound_(key));
+    }
+    auto const g = exactGroup_(key);
+    return g == nullptr ? size() : g->begin;
+  }
+
+  std::size_t
+  FileIndexDirectory::findSubRunOrRun(SubRunID const& srID) const
+  {
+    auto const c = lowerBound_(groupKey(srID));
+    return std::min(firstSubRunAtOrAfter_(c), firstRunAtOrAfter_(c));
+  }
+
+  FileIndexDirectory::Cursor
+  FileIndexDirectory::lowerBound_(EventID const& eID) const
+  {
+    auto const key = groupKey(eID.subRunID());
+    auto const g = exactGroup_(key);
+    if (g == nullptr) {
+      return lowerBound_(key);
+    }
+    std::size_t const index = g - groups_.data();
+    auto const pos = lowerBoundEvent_(*g, sortKey(eID.event()));
+    if (pos == g->end) {
+      return atGroup_(index + 1);
+    }
+    return {index, pos};
+  }
+
+  FileIndexDirectory::Cursor
+  FileIndexDirectory::lowerBound_(std::uint64_t const key) const
+  {
+    auto const it = std::lower_bound(
+      cbegin(groups_), cend(groups_), key, [](Group const& g, auto const k) {
+        return g.key < k;
+      });
+    return atGroup_(it - cbegin(groups_));
+  }
+
+  FileIndexDirectory::Cursor
+  FileIndexDirectory::atGroup_(std::size_t const group) const
+  {
+    if (group == groups_.size()) {
+      return {group, size()};
+    }
+    return {group, groups_[group].begin};
+  }
+
+  std::size_t
+  FileIndexDirectory::lowerBoundEvent_(Group const& g,
+                                       std::uint32_t const eventKey) const
+  {
+    // Branchless binary search over the (contiguous) event column of
+    // the group.
+    auto n = g.end - g.begin;
+    if (n == 0) {
+      return g.begin;
+    }
+    auto const* base = events_.data() + g.begin;
+    while (n > 1) {
+      auto const half = n / 2;
+      base = (base[half] < eventKey) ? base + half : base;
+      n -= half;
+    }
+    return (base - events_.data()) + (*base < eventKey);
+  }
+
+  FileIndexDirectory::Group const*
+  FileIndexDirectory::exactGroup_(std::uint64_t const key) const
+  {
+    auto const it = groupForKey_.find(key);
+    return it == cend(groupForKey_) ? nullptr : &groups_[it->second];
+  }
+
+  std::size_t
+  FileIndexDirectory::firstEventAtOrAfter_(Cursor const c) const
+  {
+    if (c.group == groups_.size()) {
+      return size();
+    }
+    auto const& g = groups_[c.group];
+    if (hasValidSubRun(g.key) && g.eventsBegin != g.end) {
+      return std::max(c.pos, g.eventsBegin);
+    }
+    auto const next = c.group + 1;
+    return next == groups_.size() ? size() : groups_[next].nextEvent;
+  }
+
+  std::size_t
+  FileIndexDirectory::firstSubRunAtOrAfter_(Cursor const c) const
+  {
+    if (c.group == groups_.size()) {
+      return size();
+    }
+    auto const& g = groups_[c.group];
+    if (hasValidSubRun(g.key) && c.pos < g.eventsBegin) {
+      return c.pos;
+    }
+    auto const next = c.group + 1;
+    return next == groups_.size() ? size() : groups_[next].nextSubRun;
+  }
+
+  std::size_t
+  FileIndexDirectory::firstRunAtOrAfter_(Cursor const c) const
+  {
+    if (c.group == groups_.size()) {
+      return size();
+    }
+    if (!hasValidSubRun(groups_[c.group].key)) {
+      return c.pos;
+    }
+    auto const next = c.group + 1;
+    return next == groups_.size() ? size() : groups_[next].nextRun;
+  }
+
+} // namespace art::detail
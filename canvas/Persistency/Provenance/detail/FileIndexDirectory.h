@@ -0,0 +1,101 @@
+#ifndef canvas_Persistency_Provenance_detail_FileIndexDirectory_h
+#define canvas_Persistency_Provenance_detail_FileIndexDirectory_h
+// vim: set sw=2 expandtab :
+
+////////////////////////////////////////////////////////////////////////
+//
+// FileIndexDirectory: a columnar search structure over the entries of
+// a FileIndex that has been sorted by Run, SubRun, and Event number.
+//
+// The run and subrun columns are stored run-length encoded as a
+// directory of (run, subrun) groups, each of which knows the range of
+// entries it spans.  Only the event column is stored per entry, so a
+// lookup touches the (small) directory and a contiguous array of
+// 32-bit event numbers instead of the 24-byte FileIndex::Element
+// records.
+//
+// ID numbers are stored as "sort keys" (number + 1, modulo 2^32) so
+// that the invalid value (-1) sorts first, consistent with the
+// ordering of the EventID, SubRunID and RunID comparison operators.
+//
+// All positions returned are offsets into the vector of elements from
+// which the directory was constructed, and are identical to those that
+// would be obtained by searching that vector directly.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "canvas/Persistency/Provenance/FileIndex.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace art::detail {
+
+  class FileIndexDirectory {
+  public:
+    explicit FileIndexDirectory(std::vector<FileIndex::Element> const& entries);
+
+    // Equivalent to lower_bound over the indexed entries.
+    std::size_t lowerBound(EventID const& eID) const;
+
+    // Position of the first entry of type kEvent, kSubRun or kRun at
+    // or after the lower bound of the given ID.  If exact is true, the
+    // position of the first entry matching the ID is returned.  In all
+    // cases, size() is returned if no such entry exists.
+    std::size_t findEvent(EventID const& eID, bool exact) const;
+    std::size_t findSubRun(SubRunID const& srID, bool exact) const;
+    std::size_t findRun(RunID const& rID, bool exact) const;
+
+    // Equivalent to calling findEvent for each of the IDs, which must
+    // be sorted and have a specified subrun.  The index is traversed
+    // once, with a galloping search from one ID to the next.
+    std::vector<std::size_t> findEvents(std::vector<EventID> const& eIDs,
+                                        bool exact) const;
+
+    // Position of the first entry of type kSubRun or kRun at or after
+    // the lower bound of the given subrun.
+    std::size_t findSubRunOrRun(SubRunID const& srID) const;
+
+    std::size_t size() const noexcept;
+
+  private:
+    struct Group {
+      std::uint64_t key;
+      std::size_t begin;
+      std::size_t eventsBegin;
+      std::size_t end;
+      // First entry of each type at or after begin.
+      std::size_t nextRun;
+      std::size_t nextSubRun;
+      std::size_t nextEvent;
+    };
+
+    struct Cursor {
+      std::size_t group;
+      std::size_t pos;
+    };
+
+    Cursor lowerBound_(EventID const& eID) const;
+    Cursor lowerBound_(std::uint64_t key) const;
+    Cursor atGroup_(std::size_t group) const;
+    std::size_t lowerBoundEvent_(Group const& g, std::uint32_t eventKey) const;
+    Group const* exactGroup_(std::uint64_t key) const;
+
+    std::size_t firstEventAtOrAfter_(Cursor c) const;
+    std::size_t firstSubRunAtOrAfter_(Cursor c) const;
+    std::size_t firstRunAtOrAfter_(Cursor c) const;
+
+    std::vector<std::uint32_t> events_{};
+    std::vector<Group> groups_{};
+    std::unordered_map<std::uint64_t, std::size_t> groupForKey_{};
+  };
+
+} // namespace art::detail
+
+#endif /* canvas_Persistency_Provenance_detail_FileIndexDirectory_h */
+
+// Local Variables:
+// mode: c++
+// End:
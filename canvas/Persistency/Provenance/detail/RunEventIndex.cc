@@ -0,0 +1,94 @@
+#include "canvas/Persistency/Provenance/detail/RunEventIndex.h"
+// vim: set sw=2 expandtab :
+
+#include "canvas/Persistency/Provenance/SubRunID.h"
+
+#include <algorithm>
+
+namespace art::detail {
+
+  RunEventIndex::RunEventIndex(std::vector<FileIndex::Element> const& entries)
+    : size_{entries.size()}
+  {
+    SubRunID lastSubRun{};
+    for (std::size_t i = 0; i != size_; ++i) {
+      auto const& id = entries[i].eventID;
+      if (runs_.empty() || runs_.back().run != id.run()) {
+        runs_.push_back(
+          Run{id.run(), true, events_.size(), events_.size(), size_, size_});
+      }
+      if (entries[i].getEntryType() != FileIndex::kEvent) {
+        continue;
+      }
+      auto& run = runs_.back();
+      if (run.firstEvent == size_) {
+        run.firstEvent = i;
+      }
+      if (!run.simple) {
+        continue;
+      }
+      if (run.eventsEnd != run.eventsBegin) {
+        auto const previous = events_.back().event;
+        bool const in_order = (id.subRunID() == lastSubRun) ?
+                                id.event() >= previous :
+                                id.event() > previous;
+        if (!in_order) {
+          run.simple = false;
+          events_.resize(run.eventsBegin);
+          run.eventsEnd = run.eventsBegin;
+          continue;
+        }
+      }
+      events_.push_back(Event{id.event(), i});
+      ++run.eventsEnd;
+      lastSubRun = id.subRunID();
+    }
+
+    std::size_t nextEvent{size_};
+    for (auto it = rbegin(runs_), e = rend(runs_); it != e; ++it) {
+      it->nextEvent = nextEvent;
+      if (it->firstEvent != size_) {
+        nextEvent = it->firstEvent;
+      }
+    }
+  }
+
+  std::size_t
+  RunEventIndex::size() const noexcept
+  {
+    return size_;
+  }
+
+  std::optional<std::size_t>
+  RunEventIndex::find(RunNumber_t const run,
+                      EventNumber_t const event,
+                      bool const exact) const
+  {
+    auto const r = std::lower_bound(
+      cbegin(runs_), cend(runs_), run, [](Run const& a, RunNumber_t const b) {
+        return a.run < b;
+      });
+    if (r == cend(runs_) || r->run != run) {
+      return size_;
+    }
+    if (!r->simple) {
+      return std::nullopt;
+    }
+    auto const b = cbegin(events_) + r->eventsBegin;
+    auto const e = cbegin(events_) + r->eventsEnd;
+    auto const it =
+      std::lower_bound(b, e, event, [](Event const& a, EventNumber_t const n) {
+        return a.event < n;
+      });
+    if (it != e && it->event == event) {
+      return it->pos;
+    }
+    // The subrun-by-subrun search finds nothing for an event preceding
+    // the first one in the run.
+    if (exact || it == b) {
+      return size_;
+    }
+    return it == e ? r->nextEvent : it->pos;
+  }
+
+} // namespace art::detail
@@ -0,0 +1,69 @@
+#ifndef canvas_Persistency_Provenance_detail_RunEventIndex_h
+#define canvas_Persistency_Provenance_detail_RunEventIndex_h
+// vim: set sw=2 expandtab :
+
+////////////////////////////////////////////////////////////////////////
+//
+// RunEventIndex: a (run, event) -> position index over the events of a
+// FileIndex sorted by Run, SubRun, and Event number, used to look up
+// events for which the subrun is not specified.
+//
+// Only runs with a "simple" layout are indexed: those in which every
+// subrun's event numbers are greater than all of those in the
+// preceding subruns, so that the (run, event) pair identifies an event
+// (up to duplicates within a subrun).  For those runs, find() returns
+// the same position as FileIndex's subrun-by-subrun search.  For any
+// other run, find() returns std::nullopt and that search must be used.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "canvas/Persistency/Provenance/FileIndex.h"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace art::detail {
+
+  class RunEventIndex {
+  public:
+    explicit RunEventIndex(std::vector<FileIndex::Element> const& entries);
+
+    // Position of the event, or size() if there is none.  If exact is
+    // false, the position of the event following the requested one is
+    // returned if the latter is not present.
+    std::optional<std::size_t> find(RunNumber_t run,
+                                    EventNumber_t event,
+                                    bool exact) const;
+
+    std::size_t size() const noexcept;
+
+  private:
+    struct Event {
+      EventNumber_t event;
+      std::size_t pos;
+    };
+
+    struct Run {
+      RunNumber_t run;
+      bool simple;
+      std::size_t eventsBegin;
+      std::size_t eventsEnd;
+      // Positions of the first event in, and after, this run; size()
+      // if there is none.
+      std::size_t firstEvent;
+      std::size_t nextEvent;
+    };
+
+    std::vector<Event> events_{};
+    std::vector<Run> runs_{};
+    std::size_t size_;
+  };
+
+} // namespace art::detail
+
+#endif /* canvas_Persistency_Provenance_detail_RunEventIndex_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,158 @@
+#ifndef canvas_Persistency_Provenance_detail_append_only_index_h
+#define canvas_Persistency_Provenance_detail_append_only_index_h
+// vim: set sw=2 expandtab :
+
+////////////////////////////////////////////////////////////////////////
+//
+// append_only_index: an open-addressing hash index from keys to the
+// (key, mapped) elements of a node-based container that never erases
+// any of its elements, such as the std::map of a registry.
+//
+// Lookups take no lock: the slots of the table are atomic pointers to
+// the indexed elements, published with release semantics once the
+// element has been constructed.  When the table must grow, a larger
+// copy of it is published in its place; the old table is retained
+// until the index is cleared, so that a reader still using it sees a
+// consistent, if slightly out-of-date, index.  Since each table is
+// twice the size of its predecessor, the retained tables take no more
+// memory than the current one.
+//
+// Insertions must be serialized by the caller.  Clearing the index
+// waits for the lookups in progress to finish, after which the
+// elements may be destroyed; a lookup started during or after it finds
+// nothing.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace art::detail {
+
+  template <typename K, typename V>
+  class append_only_index {
+  public:
+    append_only_index() = default;
+    ~append_only_index();
+
+    append_only_index(append_only_index const&) = delete;
+    append_only_index& operator=(append_only_index const&) = delete;
+
+    // The element whose key is 'key', or nullptr if none has been
+    // inserted.
+    V const* find(K const& key) const;
+
+    // The element must not be destroyed before the index is cleared.
+    void insert(V const& element);
+    void clear();
+
+  private:
+    struct Table {
+      explicit Table(std::size_t const capacity)
+        : mask{capacity - 1}, slots{new std::atomic<V const*>[capacity]()}
+      {}
+      std::size_t const mask;
+      std::unique_ptr<std::atomic<V const*>[]> const slots;
+      std::unique_ptr<Table> previous{};
+    };
+
+    static std::size_t hash_(K const& key);
+    static void place_(Table& table, V const& element);
+
+    std::atomic<Table*> table_{nullptr};
+    mutable std::atomic<std::size_t> readers_{};
+    std::size_t size_{};
+  };
+
+  template <typename K, typename V>
+  append_only_index<K, V>::~append_only_index()
+  {
+    clear();
+  }
+
+  template <typename K, typename V>
+  std::size_t
+  append_only_index<K, V>::hash_(K const& key)
+  {
+    return std::hash<K>{}(key);
+  }
+
+  template <typename K, typename V>
+  V const*
+  append_only_index<K, V>::find(K const& key) const
+  {
+    // The count of readers, and the table, are accessed with
+    // sequential consistency: either clear() sees this reader, or the
+    // reader sees the table removed by clear().
+    ++readers_;
+    V const* element{nullptr};
+    if (auto const* table = table_.load()) {
+      for (auto i = hash_(key) & table->mask;; i = (i + 1) & table->mask) {
+        element = table->slots[i].load(std::memory_order_acquire);
+        if (element == nullptr || element->first == key) {
+          break;
+        }
+      }
+    }
+    --readers_;
+    return element;
+  }
+
+  template <typename K, typename V>
+  void
+  append_only_index<K, V>::place_(Table& table, V const& element)
+  {
+    auto i = hash_(element.first) & table.mask;
+    while (table.slots[i].load(std::memory_order_relaxed) != nullptr) {
+      i = (i + 1) & table.mask;
+    }
+    table.slots[i].store(&element, std::memory_order_release);
+  }
+
+  template <typename K, typename V>
+  void
+  append_only_index<K, V>::insert(V const& element)
+  {
+    auto* table = table_.load(std::memory_order_relaxed);
+    // Keep the load factor at or below one half.
+    if (table == nullptr || 2 * (size_ + 1) > table->mask + 1) {
+      auto bigger =
+        std::make_unique<Table>(table == nullptr ? 16 : 2 * (table->mask + 1));
+      if (table != nullptr) {
+        for (std::size_t i = 0; i <= table->mask; ++i) {
+          if (auto const* e = table->slots[i].load(std::memory_order_relaxed)) {
+            place_(*bigger, *e);
+          }
+        }
+        bigger->previous.reset(table);
+      }
+      table = bigger.release();
+      table_.store(table, std::memory_order_release);
+    }
+    place_(*table, element);
+    ++size_;
+  }
+
+  template <typename K, typename V>
+  void
+  append_only_index<K, V>::clear()
+  {
+    std::unique_ptr<Table> table{table_.exchange(nullptr)};
+    while (readers_.load() != 0) {
+      std::this_thread::yield();
+    }
+    // Deleting the current table deletes all of its predecessors.
+    table.reset();
+    size_ = 0;
+  }
+
+} // namespace art::detail
+
+#endif /* canvas_Persistency_Provenance_detail_append_only_index_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -3,121 +3,145 @@
 
 #include "canvas/Persistency/Provenance/ProductID.h"
 #include "canvas/Utilities/FriendlyName.h"
+#include "canvas/Utilities/InternedString.h"
 #include "canvas/Utilities/TypeID.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace art;
 
 namespace {
 
-  struct CheapTag {
-    std::string label;
-    std::string instance;
-    std::string process;
+  // A product to be looked up under the given key, either as a product
+  // of that friendly class name (primary), or, for an Assns<A, B, D>, as
+  // an Assns<A, B>.
+  struct Candidate {
+    InternedString fcn;
+    InternedString process;
+    ProductID pid;
+    bool primary;
   };
 
-  inline bool
-  operator==(CheapTag const& left, CheapTag const& right)
+  std::pair<std::uintptr_t, std::uintptr_t>
+  key_of(Candidate const& c) noexcept
   {
-    return left.label == right.label && left.instance == right.instance &&
-           left.process == right.process;
+    return {c.fcn.id(), c.process.id()};
   }
 
-  class PendingBTLEntry {
-  public:
-    PendingBTLEntry(std::string const& fcn,
-                    std::string const& moduleLabel,
-                    std::string const& instanceName,
-                    std::string const& procName,
-                    ProductID const pid)
-      : fcn_{fcn}, ct_{moduleLabel, instanceName, procName}, pid_{pid}
-    {}
-
-    std::string const&
-    fcn() const noexcept
-    {
-      return fcn_;
-    }
-    CheapTag const&
-    ct() const noexcept
-    {
-      return ct_;
-    }
-    std::string const&
-    process() const noexcept
-    {
-      return ct_.process;
-    }
-    ProductID
-    pid() const
-    {
-      return pid_;
-    }
+  bool
+  is_assns_abv(ProductDescription const& pd)
+  {
+    auto const& className = pd.producedClassName();
+    return is_assns(className) && name_of_assns_base(className).empty();
+  }
 
-  private:
-    std::string fcn_;
-    CheapTag ct_;
-    ProductID pid_;
-  };
+  // The module label and instance name, compared by address.
+  std::pair<InternedString, InternedString>
+  tag_of(ProductDescription const& pd)
+  {
+    return {pd.internedModuleLabel(), pd.internedProductInstanceName()};
+  }
 }
 
-art::ProductLookup_t
+art::ProductLookupTable
 art::detail::createProductLookups(ProductDescriptionsByID const& descriptions)
+{
+  CoreDescriptionsByID cores;
+  std::vector<ProductID> all;
+  all.reserve(descriptions.size());
+  for (auto const& [pid, bd] : descriptions) {
+    cores.try_emplace(pid, std::make_shared<ProductDescription const>(bd));
+    all.push_back(pid);
+  }
+  ProductLookupTable result;
+  addProductLookups(result, cores, all);
+  return result;
+}
+
+std::vector<art::ProductLookupTable::Key>
+art::detail::addProductLookups(ProductLookupTable& table,
+                               CoreDescriptionsByID const& descriptions,
+                               std::vector<ProductID> const& added)
 {
   // Computing the product lookups does not rely on any ROOT facilities.
-  ProductLookup_t result;
-  std::vector<PendingBTLEntry> pendingEntries;
-  std::unordered_map<ProductID, CheapTag, ProductID::Hash> insertedABVs;
-  for (auto const& [pid, pd] : descriptions) {
-    auto const& prodFCN = pd.friendlyClassName();
-    auto const& procName = pd.processName();
-    result[prodFCN][procName].emplace_back(pid);
+  std::vector<Candidate> candidates;
+  candidates.reserve(added.size());
+  for (auto const pid : added) {
+    auto const& pd = *descriptions.at(pid);
+    auto const procName = pd.internedProcessName();
+    candidates.push_back({pd.internedFriendlyClassName(), procName, pid, true});
 
     // Additional work only for Assns lookup
-    auto const& moduleLabel = pd.moduleLabel();
-    auto const& instanceName = pd.productInstanceName();
     auto const& className = pd.producedClassName();
-
     if (!is_assns(className))
       continue;
 
     auto const baseName = name_of_assns_base(className);
     if (!baseName.empty()) {
       // We're an Assns<A, B, D>, with a base Assns<A, B>.
-      pendingEntries.emplace_back(art::friendlyname::friendlyName(baseName),
-                                  moduleLabel,
-                                  instanceName,
-                                  procName,
-                                  pid);
-    } else {
-      // Add our pid to the list of real Assns<A, B, void>
-      // products already registered.
-      insertedABVs.emplace(pid, CheapTag{moduleLabel, instanceName, procName});
+      candidates.push_back(
+        {InternedString{art::friendlyname::friendlyName(baseName)},
+         procName,
+         pid,
+         false});
     }
   }
+  std::stable_sort(candidates.begin(),
+                   candidates.end(),
+                   [](Candidate const& a, Candidate const& b) {
+                     return key_of(a) < key_of(b);
+                   });
 
-  auto const iend = insertedABVs.cend();
-  // Preserve useful ordering, only inserting if we don't already have
-  // a *real* Assns<A, B, void> for that module label / instance name
-  // combination.
-  std::for_each(
-    pendingEntries.cbegin(),
-    pendingEntries.cend(),
-    [&result, &insertedABVs, iend](auto const& pe) {
-      auto& pids = result[pe.fcn()][pe.process()];
-      if (pids.empty() ||
-          !std::any_of(pids.cbegin(),
-                       pids.cend(),
-                       [&insertedABVs, &iend, &pe](ProductID const pid) {
-                         auto i = insertedABVs.find(pid);
-                         return i != iend && pe.ct() == i->second;
-                       })) {
-        pids.emplace_back(pe.pid());
-      }
-    });
+  // The product IDs of each key affected by the added products are
+  // recomputed from those already in the table and the added ones: the
+  // products of the key's friendly class name first, and then the
+  // Assns<A, B, D> products, each in order of product ID.
+  std::vector<ProductLookupTable::Row> rows;
+  std::vector<ProductLookupTable::Key> keys;
+  for (auto b = candidates.cbegin(), e = b; b != candidates.cend(); b = e) {
+    e = std::find_if(
+      b, candidates.cend(), [k = key_of(*b)](Candidate const& c) {
+        return key_of(c) != k;
+      });
+    auto const fcn = b->fcn;
+    auto const process = b->process;
+    std::vector<ProductID> primaries;
+    std::vector<ProductID> pending;
+    for (auto const pid : table.productIDs(fcn, process)) {
+      auto& pids =
+        descriptions.at(pid)->internedFriendlyClassName() == fcn ? primaries :
+                                                                  pending;
+      pids.push_back(pid);
+    }
+    for (auto c = b; c != e; ++c) {
+      (c->primary ? primaries : pending).push_back(c->pid);
+    }
+    std::sort(primaries.begin(), primaries.end());
+    std::sort(pending.begin(), pending.end());
 
-  return result;
+    // Preserve useful ordering, only inserting if we don't already
+    // have a *real* Assns<A, B, void> for that module label / instance
+    // name combination.
+    std::vector<std::pair<InternedString, InternedString>> abvTags;
+    for (auto const pid : primaries) {
+      rows.push_back({fcn, process, pid});
+      if (auto const& pd = *descriptions.at(pid); is_assns_abv(pd)) {
+        abvTags.push_back(tag_of(pd));
+      }
+    }
+    for (auto const pid : pending) {
+      auto const tag = tag_of(*descriptions.at(pid));
+      if (std::find(abvTags.cbegin(), abvTags.cend(), tag) == abvTags.cend()) {
+        rows.push_back({fcn, process, pid});
+      }
+    }
+    keys.push_back({fcn, process});
+  }
+  table.update(std::move(rows));
+  return keys;
 }
@@ -2,11 +2,25 @@
 #define canvas_Persistency_Provenance_detail_createProductLookups_h
 
 #include "canvas/Persistency/Provenance/BranchDescription.h"
+#include "canvas/Persistency/Provenance/ProductDescription.h"
+#include "canvas/Persistency/Provenance/ProductLookupTable.h"
 #include "canvas/Persistency/Provenance/type_aliases.h"
 
+#include <vector>
+
 namespace art::detail {
-  ProductLookup_t createProductLookups(
+  ProductLookupTable createProductLookups(
     ProductDescriptionsByID const& descriptions);
+
+  // Adds to table, which holds the lookups of the products of
+  // descriptions other than those added, the lookups of the added
+  // products.  The result is that of createProductLookups() for the
+  // same products, but only the lookups of the keys of the added
+  // products, which are returned, are recomputed.
+  std::vector<ProductLookupTable::Key> addProductLookups(
+    ProductLookupTable& table,
+    CoreDescriptionsByID const& descriptions,
+    std::vector<ProductID> const& added);
 }
 
 #endif /* canvas_Persistency_Provenance_detail_createProductLookups_h */
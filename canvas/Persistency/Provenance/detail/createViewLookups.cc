@@ -1,17 +1,64 @@
 #include "canvas/Persistency/Provenance/detail/createViewLookups.h"
 // vim: set sw=2:
 
-art::ViewLookup_t
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+art::ProductLookupTable
 art::detail::createViewLookups(ProductDescriptionsByID const& descriptions)
 {
-  // This version stores the list of products that support views.
-  ViewLookup_t result;
-  for (auto const& [pid, pd] : descriptions) {
+  CoreDescriptionsByID cores;
+  std::vector<ProductID> all;
+  all.reserve(descriptions.size());
+  for (auto const& [pid, bd] : descriptions) {
+    cores.try_emplace(pid, std::make_shared<ProductDescription const>(bd));
+    all.push_back(pid);
+  }
+  ProductLookupTable result;
+  addViewLookups(result, cores, all);
+  return result;
+}
+
+std::vector<art::ProductLookupTable::Key>
+art::detail::addViewLookups(ProductLookupTable& table,
+                            CoreDescriptionsByID const& descriptions,
+                            std::vector<ProductID> const& added)
+{
+  // This version stores the list of products that support views, in
+  // order of product ID for each process.
+  std::vector<std::pair<InternedString, ProductID>> candidates;
+  for (auto const pid : added) {
+    auto const& pd = *descriptions.at(pid);
     if (!pd.supportsView())
       continue;
 
-    auto const& procName = pd.processName();
-    result[procName].emplace_back(pid);
+    candidates.emplace_back(pd.internedProcessName(), pid);
   }
-  return result;
+  std::stable_sort(
+    candidates.begin(), candidates.end(), [](auto const& a, auto const& b) {
+      return a.first.id() < b.first.id();
+    });
+
+  InternedString const noClassName{};
+  std::vector<ProductLookupTable::Row> rows;
+  std::vector<ProductLookupTable::Key> keys;
+  for (auto b = candidates.cbegin(), e = b; b != candidates.cend(); b = e) {
+    auto const process = b->first;
+    e = std::find_if(b, candidates.cend(), [process](auto const& c) {
+      return c.first != process;
+    });
+    auto const existing = table.productIDs(noClassName, process);
+    std::vector<ProductID> pids(existing.begin(), existing.end());
+    for (auto c = b; c != e; ++c) {
+      pids.push_back(c->second);
+    }
+    std::sort(pids.begin(), pids.end());
+    for (auto const pid : pids) {
+      rows.push_back({noClassName, process, pid});
+    }
+    keys.push_back({noClassName, process});
+  }
+  table.update(std::move(rows));
+  return keys;
 }
@@ -0,0 +1,29 @@
+#include "canvas/Persistency/Provenance/detail/findEventBySubRunWalk.h"
+// vim: set sw=2 expandtab :
+
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+bool
+art::detail::subRunUnspecified(EventID const& eID)
+{
+  // This is nasty, principally because we don't want to be
+  // encouraging too many people to do this. Basically, we're
+  // checking whether the only reason an EventID is invalid is
+  // because its subRun number is invalid.
+  return (!eID.isValid()) && eID.runID().isValid() &&
+         EventID(SubRunID::firstSubRun(), eID.event()).isValid();
+}
+
+void
+art::detail::warnUnspecifiedSubRunSearch(EventID const& eID)
+{
+  mf::LogWarning("FileIndex")
+    << "Could not find incompletely specified event " << eID
+    << " with smart algorithm:\n"
+    << "Assuming pathological file structure (event selection?) and\n"
+    << "trying again (inefficient).\n"
+    << "NOTE: this will find only the event with matching event number "
+    << "and the\n"
+    << "      lowest subrun number: any others are inaccessible via this "
+    << "method.";
+}
@@ -0,0 +1,95 @@
+#ifndef canvas_Persistency_Provenance_detail_findEventBySubRunWalk_h
+#define canvas_Persistency_Provenance_detail_findEventBySubRunWalk_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+//
+// findEventBySubRunWalk: find an event whose subrun is not specified by
+// jumping subrun by subrun through an index sorted by Run, SubRun, and
+// Event number.  The Index type must provide
+//
+//   const_iterator findPosition(EventID const&, bool exact) const;
+//   const_iterator cend() const;
+//
+// where const_iterator dereferences to a FileIndex::Element.
+//
+// ======================================================================
+
+#include "canvas/Persistency/Provenance/EventID.h"
+
+namespace art::detail {
+
+  // True if the only reason the ID is invalid is that its subrun
+  // number is invalid.
+  bool subRunUnspecified(EventID const& eID);
+
+  void warnUnspecifiedSubRunSearch(EventID const& eID);
+
+  template <typename Index>
+  auto
+  findEventBySubRunWalk(Index const& index, EventID const& eID, bool exact)
+  {
+    RunID const& runID = eID.runID();
+    EventNumber_t event = eID.event();
+    SubRunID last_subRunID;
+    // Try to find the event.
+    auto const firstEvent = index.findPosition(
+      EventID::firstEvent(SubRunID::firstSubRun(runID)), false);
+    auto it = firstEvent;
+    auto const itEnd = index.cend();
+    if (it == itEnd) {
+      return it;
+    }
+
+    // Starting with it, jump to the first event of each subrun until
+    // we find either:
+    //
+    // 1. The next run.
+    // 2. An event number higher than we want.
+    // 3. The end of the file index.
+    while ((it != itEnd) && (it->eventID.runID() == runID) &&
+           (it->eventID.event() < event)) {
+      last_subRunID = it->eventID.subRunID();
+      // Get the first event in the next subrun.
+      it = index.findPosition(
+        EventID::firstEvent(it->eventID.subRunID().next()), false);
+    }
+    auto result = itEnd;
+    if ((it != itEnd) && (it->eventID.runID() == runID) &&
+        (it->eventID.event() == event)) {
+      // We started on the correct event.
+      result = it;
+    } else if (last_subRunID.isValid()) {
+      // Find the event in the last subrun.
+      result = index.findPosition(EventID(last_subRunID, event), exact);
+    }
+    if (result == itEnd) {
+      // Did not find anything.
+      warnUnspecifiedSubRunSearch(eID);
+      SubRunID trySubRun{SubRunID::firstSubRun(runID)};
+      // Try to find the highest subrun number in this run.
+      auto findIt = firstEvent;
+      SubRunID lastSubRunInRun{trySubRun};
+      for (; findIt != itEnd && findIt->eventID.runID() == runID;
+           findIt = index.findPosition(
+             EventID::firstEvent(lastSubRunInRun.next()), false)) {
+        lastSubRunInRun = findIt->eventID.subRunID();
+      }
+      // Now loop through each subrun looking for an exact match to our event.
+      while ((findIt = index.findPosition(EventID(trySubRun, event), true)) ==
+               itEnd &&
+             trySubRun < lastSubRunInRun) {
+        trySubRun = trySubRun.next();
+      }
+      result = findIt;
+    }
+    return result;
+  }
+
+} // namespace art::detail
+
+#endif /* canvas_Persistency_Provenance_detail_findEventBySubRunWalk_h */
+
+// Local Variables:
+// mode: c++
+// End:
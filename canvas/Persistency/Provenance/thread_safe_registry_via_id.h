@@ -12,21 +12,30 @@
 // changing during a read, then a guard must be placed around the
 // registry traversal.
 //
-// Inefficiencies:
+// Looking up a single entry, with find() or get(key, mapped), takes
+// no lock when the entry is found: the entries are also indexed by an
+// append_only_index, which may be read while it is being added to.
+// An entry inserted directly into the map returned by instance() is
+// not indexed; it is looked for in the map, under the lock, and
+// indexed when it is first found there.  The pointer returned by
+// find() remains valid until the registry is cleaned up, which waits
+// for the lookups in progress.
 //
-// - To insert pairs from an std::map<K,M> object, one must emplace
-//   each pair one at a time.  This seems to be very inefficient;
-//   however, unless we are willing to pay the consequences for
-//   changing the underlying types of some of the persisted objects
-//   that are represented in memory by the below registry, there may
-//   not be a better solution.
+// Inserting the pairs of a container with put() is done in a single
+// pass when the container is sorted by key, as is an std::map<K,M>
+// object: each key is looked for starting from the position of the
+// previous one.  Keys already present are skipped without allocating
+// a node for them.  A node is still allocated for each new entry, as
+// the registry is exposed as an std::map<K,M> object through get().
 // ===================================================================
 
 #include "canvas/Persistency/Provenance/Hash.h"
+#include "canvas/Persistency/Provenance/detail/append_only_index.h"
 
 #include <map>
 #include <mutex>
 #include <type_traits>
+#include <utility>
 
 namespace art {
   template <typename K, typename M>
@@ -42,12 +51,14 @@ namespace art {
     static bool empty();
     static collection_type const& get();
     static bool get(K const& key, M& mapped);
+    static M const* find(K const& key);
     static auto
     instance(bool cleanup = false)
     {
       std::lock_guard sentry{mutex_()};
       static collection_type* me = new collection_type{};
       if (cleanup) {
+        index_().clear();
         delete me;
         me = nullptr;
         return me;
@@ -60,14 +71,40 @@ namespace art {
     }
 
   private:
+    using index_type = detail::append_only_index<K, value_type>;
+
+    template <typename Result>
+    static Result const& indexed_(Result const& result);
+
     static auto&
     mutex_()
     {
       static std::recursive_mutex m{};
       return m;
     }
+
+    static index_type&
+    index_()
+    {
+      // Never destroyed, so that it may be used during static
+      // destruction.
+      static auto* index = new index_type{};
+      return *index;
+    }
   };
 
+  // Adds the element to the index if it was inserted into the map.
+  template <typename K, typename M>
+  template <typename Result>
+  Result const&
+  thread_safe_registry_via_id<K, M>::indexed_(Result const& result)
+  {
+    if (result.second) {
+      index_().insert(*result.first);
+    }
+    return result;
+  }
+
   template <typename K, typename M>
   template <typename C>
   void
@@ -75,8 +112,27 @@ namespace art {
   {
     std::lock_guard sentry{mutex_()};
     auto me = instance();
+    auto const end = me->end();
+    auto pos = me->begin();
     for (auto const& e : container) {
-      me->emplace(e);
+      auto const& key = e.first;
+      // For sorted input, the key belongs at or after pos.  Walk a few
+      // steps from there before resorting to a search of the map.
+      for (int steps = 0; pos != end && pos->first < key; ++steps) {
+        if (steps == 8) {
+          pos = me->lower_bound(key);
+          break;
+        }
+        ++pos;
+      }
+      if (pos != end && pos->first == key) {
+        continue;
+      }
+      auto const size = me->size();
+      pos = me->emplace_hint(pos, e);
+      // The hint is wrong if the input is not sorted: the key may then
+      // have been present after all.
+      indexed_(std::make_pair(pos, me->size() != size));
     }
   }
 
@@ -85,7 +141,7 @@ namespace art {
   thread_safe_registry_via_id<K, M>::emplace(value_type const& value)
   {
     std::lock_guard sentry{mutex_()};
-    return instance()->emplace(value);
+    return indexed_(instance()->emplace(value));
   }
 
   template <typename K, typename M>
@@ -93,7 +149,7 @@ namespace art {
   thread_safe_registry_via_id<K, M>::emplace(K const& key, M const& mapped)
   {
     std::lock_guard sentry{mutex_()};
-    return instance()->emplace(key, mapped);
+    return indexed_(instance()->emplace(key, mapped));
   }
 
   template <typename K, typename M>
@@ -115,15 +171,32 @@ namespace art {
   bool
   thread_safe_registry_via_id<K, M>::get(K const& k, M& mapped)
   {
-    std::lock_guard sentry{mutex_()};
-    auto me = instance();
-    auto it = me->find(k);
-    if (it != me->cend()) {
-      mapped = it->second;
+    if (auto const* found = find(k)) {
+      mapped = *found;
       return true;
     }
     return false;
   }
+
+  template <typename K, typename M>
+  M const*
+  thread_safe_registry_via_id<K, M>::find(K const& k)
+  {
+    if (auto const* element = index_().find(k)) {
+      return &element->second;
+    }
+    std::lock_guard sentry{mutex_()};
+    auto me = instance();
+    auto const it = me->find(k);
+    if (it == me->cend()) {
+      return nullptr;
+    }
+    // Another thread may have indexed it since it was looked for.
+    if (index_().find(k) == nullptr) {
+      index_().insert(*it);
+    }
+    return &it->second;
+  }
 }
 
 #endif /* canvas_Persistency_Provenance_thread_safe_registry_via_id_h */
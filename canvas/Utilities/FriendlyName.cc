@@ -3,137 +3,289 @@
 
 #include "canvas/Utilities/Exception.h"
 
-#include <map>
-#include <mutex>
-#include <regex>
+#include "tbb/concurrent_unordered_map.h"
+
+#include <algorithm>
+#include <iterator>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// The friendly name of a type is formed by applying a fixed set of
+// renames (e.g. std::vector -> s) to its name, and then rewriting each
+// template node of the name, innermost (and leftmost) first, as the
+// concatenation of its (rewritten) template arguments followed by the
+// template's name.  The arguments of an art::Assns are first put in a
+// canonical order.
+//
+// Friendly names are part of product names, and hence of the branch
+// names in existing files: the output must not change.  The original,
+// regular-expression-based implementation rewrote a template node by
+// replacing all of its occurrences in the name at once, including
+// those that end a longer template name (e.g. the A<b> of ns::A<b>).
+// The template arguments are parsed, in one pass, as a tree whose
+// nodes are rewritten as they are closed; a node that such a
+// replacement would have reached first is rewritten as it was.
 
-// NOTE: This should probably be rewritten so that we break the class
-// name into a tree where the template arguments are the node.  On the
-// way down the tree we look for '<' or ',' and on the way up (caused by
-// finding a '>') we can apply the transformation to the output string
-// based on the class name for the templated class.  Up front we'd
-// register a class name to a transformation function (which would
-// probably take a std::vector<std::string> which holds the results of
-// the node transformations).
+using namespace std::string_view_literals;
 
 namespace {
 
-  std::regex const reAllSpaces{" +"};
-  std::regex const reAssns{"art::Assns"};
-  std::regex const reBeginSpace{"^ +"};
-  std::regex const reComma{","};
-  std::regex const reEndSpace{" +$"};
-  std::regex const reParens{"(\\(|\\))"};
-  std::regex const reFirstTwoArgs{"^([^,]+),([^,]+)"};
-  std::regex const reLong{"long "};
-  std::regex const reLongLong{"Long64_t"};
-  std::regex const reMapVector{"cet::map_vector"};
-  std::regex const reMapVectorKey{"cet::map_vector_key"};
-  std::regex const reString{"(?:std::basic_string<char>|std::string)"};
-  std::regex const reTemplateArgs{"([^<]*)<(.*)>$"};
-  std::regex const reTemplateClass{"([^<>,]+<[^<>]*>)"};
-  std::regex const reULongLong{"ULong64_t"};
-  std::regex const reUnsigned{"unsigned "};
-  std::regex const reVector{"std::vector"};
-  std::regex const reWrapper{"art::Wrapper<(.*)>"};
-
-  std::string const emptyString{};
+  constexpr auto npos = std::string::npos;
 
-  std::string
-  removeExtraSpaces(std::string const& in)
+  std::string_view
+  removeExtraSpaces(std::string_view const in)
   {
-    return std::regex_replace(std::regex_replace(in, reBeginSpace, emptyString),
-                              reEndSpace,
-                              emptyString);
+    auto const b = in.find_first_not_of(' ');
+    if (b == npos) {
+      return {};
+    }
+    return in.substr(b, in.find_last_not_of(' ') + 1 - b);
   }
 
-  std::string
-  removeAllSpaces(std::string const& in)
+  void
+  removeAll(std::string& s, char const c)
   {
-    return std::regex_replace(in, reAllSpaces, emptyString);
+    s.erase(std::remove(s.begin(), s.end(), c), s.end());
   }
 
+  struct Rename {
+    std::string_view from;
+    std::string_view to;
+  };
+
+  // Where more than one of these would match at the same position, the
+  // first is applied.
+  constexpr Rename renames[]{{"std::basic_string<char>"sv, "String"sv},
+                             {"std::string"sv, "String"sv},
+                             {"unsigned "sv, "u"sv},
+                             {"long "sv, "l"sv},
+                             {"ULong64_t"sv, "ull"sv},
+                             {"Long64_t"sv, "ll"sv},
+                             {"std::vector"sv, "s"sv},
+                             {"cet::map_vector_key"sv, "mvk"sv},
+                             {"cet::map_vector"sv, "mv"sv}};
+
   std::string
-  escapeParens(std::string const& in)
+  standardRenames(std::string const& in)
+  {
+    std::string_view name{in};
+    // Strip the first art::Wrapper, taking its closing '>' to be the
+    // last one of the name.
+    std::string unwrapped;
+    constexpr auto wrapper = "art::Wrapper<"sv;
+    if (auto const b = name.find(wrapper); b != npos) {
+      if (auto const e = name.rfind('>');
+          e != npos && e >= b + wrapper.size()) {
+        unwrapped.reserve(name.size());
+        unwrapped.append(name, 0, b)
+          .append(name, b + wrapper.size(), e - b - wrapper.size())
+          .append(name, e + 1);
+        name = unwrapped;
+      }
+    }
+
+    std::string result;
+    result.reserve(name.size());
+    while (!name.empty()) {
+      auto const r = std::find_if(
+        std::begin(renames), std::end(renames), [name](Rename const& r) {
+          return name.compare(0, r.from.size(), r.from) == 0;
+        });
+      if (r == std::end(renames)) {
+        result += name.front();
+        name.remove_prefix(1);
+      } else {
+        result += r->to;
+        name.remove_prefix(r->from.size());
+      }
+    }
+    return result;
+  }
+
+  void
+  maybeSwapFirstTwoArgs(std::string& args)
   {
-    return std::regex_replace(in, reParens, "\\$1");
+    auto const comma = args.find(',');
+    if (comma == 0 || comma == npos) {
+      return;
+    }
+    auto const end = std::min(args.find(',', comma + 1), args.size());
+    std::string_view const all{args};
+    auto const first = all.substr(0, comma);
+    auto const second = all.substr(comma + 1, end - comma - 1);
+    if (!second.empty() && first > second) {
+      std::string swapped;
+      swapped.reserve(args.size());
+      swapped.append(second).append(1, ',').append(first).append(
+        all.substr(end));
+      args = std::move(swapped);
+    }
   }
 
-  std::string
-  standardRenames(std::string const& in)
+  art::Exception
+  noTemplateMatch(std::string_view const args)
   {
-    std::string name{std::regex_replace(in, reWrapper, "$1")};
-    name = std::regex_replace(name, reString, "String");
-    name = std::regex_replace(name, reUnsigned, "u");
-    name = std::regex_replace(name, reLong, "l");
-    name = std::regex_replace(name, reULongLong, "ull");
-    name = std::regex_replace(name, reLongLong, "ll");
-    name = std::regex_replace(name, reVector, "s");
-    name = std::regex_replace(name, reMapVectorKey, "mvk");
-    name = std::regex_replace(name, reMapVector, "mv");
-    return name;
+    return art::Exception(art::errors::LogicError)
+           << "No template match for \"" << args << '"';
   }
 
-  // Declaration required here because handleTemplateArguments and
-  // subFriendlyName call each other.
-  std::string handleTemplateArguments(std::string const&, std::string const&);
+  // The template arguments, separated by commas, with their
+  // surrounding spaces removed, the first two swapped for an
+  // art::Assns, and the commas then removed.
   std::string
-  subFriendlyName(std::string const& iFullName)
+  joinArguments(std::string_view const cName, std::string_view const args)
   {
-    std::string result{removeExtraSpaces(iFullName)};
-    std::smatch theMatch;
-    if (std::regex_match(result, theMatch, reTemplateArgs)) {
-      std::string const cMatch{theMatch.str(1)};
-      std::string const aMatch{theMatch.str(2)};
-      std::string const theSub{handleTemplateArguments(cMatch, aMatch)};
-      // If a type (e.g.) A was declared in an anonymous namespace,
-      // the demangled typename can be (anonymous namespace)::A.  The
-      // parentheses must be escaped so that they do not interfere
-      // with the regex library.
-      std::regex const eMatch{std::string{"^"} + escapeParens(cMatch) + '<' +
-                              escapeParens(aMatch) + '>'};
-      result = std::regex_replace(result, eMatch, theSub + cMatch);
+    std::string result{removeExtraSpaces(args)};
+    if (cName == "art::Assns"sv) {
+      maybeSwapFirstTwoArgs(result);
     }
+    removeAll(result, ',');
     return result;
   }
 
-  void
-  maybeSwapFirstTwoArgs(std::string& result)
+  // Parses a list of template arguments as a tree of template nodes,
+  // rewriting each node when it is closed.
+  class TemplateArguments {
+  public:
+    explicit TemplateArguments(std::string_view const args) : args_{args} {}
+
+    // The arguments, as written, but with their template nodes
+    // rewritten.
+    std::string
+    rewritten()
+    {
+      std::string result;
+      std::size_t finished{};
+      while (true) {
+        result += argument(finished, true);
+        if (pos_ == args_.size()) {
+          return result;
+        }
+        ++pos_;
+        result += ',';
+      }
+    }
+
+  private:
+    // A node, as it was written once its arguments were rewritten, and
+    // its rewritten form.
+    struct Rewrite {
+      std::string from;
+      std::string to;
+    };
+
+    std::string argument(std::size_t& finished, bool outermost);
+    std::string node(std::string_view name,
+                     std::string_view nodeArgs,
+                     std::size_t since,
+                     std::size_t& finished);
+
+    std::string_view args_;
+    std::size_t pos_{};
+    // In the order in which they were made.
+    std::vector<Rewrite> rewrites_{};
+  };
+
+  // The argument starting at pos_, up to the ',' or '>' that ends it.
+  // Outside any node, a '>' is kept as written, and delimits the name
+  // of a following node, as in the original implementation.  The index
+  // of the rewrite that finished its last node, plus one, is
+  // accumulated in 'finished'.
+  std::string
+  TemplateArguments::argument(std::size_t& finished, bool const outermost)
   {
-    std::smatch theMatch;
-    if (std::regex_search(result, theMatch, reFirstTwoArgs) &&
-        (theMatch.str(1) > theMatch.str(2))) {
-      result = std::regex_replace(result, reFirstTwoArgs, "$2,$1");
+    std::string text;
+    std::size_t nameBegin{};
+    while (pos_ != args_.size()) {
+      auto const next =
+        std::min(args_.find_first_of("<>,"sv, pos_), args_.size());
+      text.append(args_, pos_, next - pos_);
+      pos_ = next;
+      if (pos_ == args_.size() || args_[pos_] == ',') {
+        break;
+      }
+      if (args_[pos_] == '>') {
+        if (!outermost) {
+          break;
+        }
+        text += args_[pos_++];
+        nameBegin = text.size();
+        continue;
+      }
+      if (nameBegin == text.size()) {
+        throw noTemplateMatch(args_);
+      }
+      ++pos_;
+      std::string nodeArgs;
+      // The node becomes innermost once its last node argument is
+      // finished.
+      std::size_t since{};
+      while (true) {
+        nodeArgs += argument(since, false);
+        if (pos_ == args_.size()) {
+          throw noTemplateMatch(args_);
+        }
+        if (args_[pos_++] == '>') {
+          break;
+        }
+        nodeArgs += ',';
+      }
+      auto rewritten = node(
+        std::string_view{text}.substr(nameBegin), nodeArgs, since, finished);
+      text.replace(nameBegin, npos, rewritten);
     }
+    return text;
   }
 
+  // The rewritten form of the node name<nodeArgs>, which has been
+  // innermost since the rewrite with the given index.
   std::string
-  handleTemplateArguments(std::string const& cName, std::string const& tArgs)
+  TemplateArguments::node(std::string_view const name,
+                          std::string_view const nodeArgs,
+                          std::size_t const since,
+                          std::size_t& finished)
   {
-    std::string result{removeExtraSpaces(tArgs)};
-    bool shouldStop{false};
-    while (!shouldStop) {
-      if (std::string::npos != result.find_first_of("<")) {
-        std::smatch theMatch;
-        if (std::regex_search(result, theMatch, reTemplateClass)) {
-          std::string const templateClass{theMatch.str(1)};
-          std::string const friendlierName{
-            removeAllSpaces(subFriendlyName(templateClass))};
-          result = std::regex_replace(
-            result, std::regex(templateClass), friendlierName);
-        } else {
-          throw art::Exception(art::errors::LogicError)
-            << "No template match for \"" << result << '"';
-        }
-      } else {
-        shouldStop = true;
+    std::string written;
+    written.reserve(name.size() + nodeArgs.size() + 2);
+    written.append(name).append(1, '<').append(nodeArgs).append(1, '>');
+
+    // The first rewrite since then of a node that ends this one would
+    // have replaced that part of it.
+    for (auto i = since; i != rewrites_.size(); ++i) {
+      auto const& [from, to] = rewrites_[i];
+      if (from.size() <= written.size() &&
+          written.compare(written.size() - from.size(), npos, from) == 0) {
+        finished = std::max(finished, i + 1);
+        written.replace(written.size() - from.size(), npos, to);
+        return written;
       }
     }
-    if (std::regex_match(cName, reAssns)) {
-      maybeSwapFirstTwoArgs(result);
+
+    auto const cName = name.substr(std::min(name.find_first_not_of(' '),
+                                            name.size()));
+    auto result = joinArguments(cName, nodeArgs);
+    result += cName;
+    removeAll(result, ' ');
+    rewrites_.push_back({std::move(written), result});
+    finished = std::max(finished, rewrites_.size());
+    return result;
+  }
+
+  std::string
+  subFriendlyName(std::string_view const fullName)
+  {
+    auto const name = removeExtraSpaces(fullName);
+    auto const open = name.find('<');
+    if (open == npos || name.back() != '>') {
+      return std::string{name};
     }
-    result = std::regex_replace(result, reComma, emptyString);
+    auto const cName = name.substr(0, open);
+    auto const args =
+      removeExtraSpaces(name.substr(open + 1, name.size() - open - 2));
+    auto result = joinArguments(cName, TemplateArguments{args}.rewritten());
+    result += cName;
     return result;
   }
 
@@ -142,14 +294,10 @@ namespace {
 std::string
 art::friendlyname::friendlyName(std::string const& iFullName)
 {
-  static std::recursive_mutex s_mutex;
-  static std::map<std::string, std::string> s_nameMap;
-  std::lock_guard sentry{s_mutex};
-  auto entry = s_nameMap.find(iFullName);
-  if (entry == s_nameMap.end()) {
-    entry =
-      s_nameMap.emplace(iFullName, subFriendlyName(standardRenames(iFullName)))
-        .first;
+  static tbb::concurrent_unordered_map<std::string, std::string> s_nameMap;
+  if (auto const entry = s_nameMap.find(iFullName); entry != s_nameMap.end()) {
+    return entry->second;
   }
-  return entry->second;
+  auto name = subFriendlyName(standardRenames(iFullName));
+  return s_nameMap.emplace(iFullName, std::move(name)).first->second;
 }
@@ -0,0 +1,59 @@
+#include "canvas/Utilities/InternedString.h"
+// vim: set sw=2 expandtab :
+
+#include "tbb/concurrent_unordered_map.h"
+
+#include <memory>
+#include <utility>
+
+using namespace std;
+
+namespace {
+
+  // Each key views the string owned by its own entry, whose address
+  // does not change once inserted.
+  auto&
+  interned_strings()
+  {
+    static tbb::concurrent_unordered_map<string_view, unique_ptr<string const>>
+      strings{};
+    return strings;
+  }
+
+  string const*
+  intern(string_view const s)
+  {
+    auto& strings = interned_strings();
+    if (auto it = strings.find(s); it != strings.end()) {
+      return it->second.get();
+    }
+    // If another thread inserts the same string first, its entry is
+    // used, and ours discarded.
+    auto owned = make_unique<string const>(s);
+    string_view const key{*owned};
+    return strings.emplace(key, move(owned)).first->second.get();
+  }
+
+} // unnamed namespace
+
+namespace art {
+
+  InternedString::InternedString()
+  {
+    static string const* const empty{intern({})};
+    str_ = empty;
+  }
+
+  InternedString::InternedString(string_view const s) : str_{intern(s)} {}
+
+  optional<InternedString>
+  InternedString::find(string_view const s)
+  {
+    auto const& strings = interned_strings();
+    if (auto it = strings.find(s); it != strings.end()) {
+      return InternedString{it->second.get()};
+    }
+    return nullopt;
+  }
+
+} // namespace art
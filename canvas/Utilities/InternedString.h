@@ -0,0 +1,78 @@
+#ifndef canvas_Utilities_InternedString_h
+#define canvas_Utilities_InternedString_h
+// vim: set sw=2 expandtab :
+
+// InternedString: a string stored once, for the lifetime of the
+// program, in a process-wide table.  Equal strings are represented by
+// the same stored string, so that InternedString objects are compared
+// and hashed by the address of that string (id()) rather than by their
+// characters.
+//
+// Interning a string requires one hash of its characters; finding an
+// interned string does not intern it.  Both are safe to call
+// concurrently, and take no lock if the string is already interned.
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace art {
+
+  class InternedString {
+  public:
+    // The empty string.
+    InternedString();
+    explicit InternedString(std::string_view s);
+
+    // The interned string equal to s, if one exists.
+    static std::optional<InternedString> find(std::string_view s);
+
+    std::string const&
+    str() const noexcept
+    {
+      return *str_;
+    }
+
+    // Unique to the string's characters for the lifetime of the
+    // program, but otherwise unspecified: in particular, the ordering
+    // of ids is not that of the strings.
+    std::uintptr_t
+    id() const noexcept
+    {
+      return reinterpret_cast<std::uintptr_t>(str_);
+    }
+
+    bool
+    operator==(InternedString const other) const noexcept
+    {
+      return str_ == other.str_;
+    }
+    bool
+    operator!=(InternedString const other) const noexcept
+    {
+      return str_ != other.str_;
+    }
+
+    struct Hash {
+      std::size_t
+      operator()(InternedString const s) const noexcept
+      {
+        // Stored strings are at least pointer-aligned.
+        return s.id() / alignof(std::string);
+      }
+    };
+
+  private:
+    explicit InternedString(std::string const* s) noexcept : str_{s} {}
+    std::string const* str_;
+  };
+
+} // namespace art
+
+#endif /* canvas_Utilities_InternedString_h */
+
+// Local Variables:
+// mode: c++
+// End:
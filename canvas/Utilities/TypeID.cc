@@ -4,20 +4,25 @@
 #include "canvas/Utilities/Exception.h"
 #include "canvas/Utilities/FriendlyName.h"
 #include "canvas/Utilities/uniform_type_name.h"
+#include "tbb/concurrent_unordered_map.h"
 
 #include <cstddef>
-#include <map>
-#include <mutex>
 #include <ostream>
 #include <string>
 #include <typeinfo>
+#include <unordered_map>
 #include <utility>
 
 using namespace std;
 
 namespace {
-  map<size_t, string> name_cache{};
-  mutex cache_mutex{};
+  // Lookups take no lock, and the stored names are never moved.
+  auto&
+  name_cache()
+  {
+    static tbb::concurrent_unordered_map<size_t, string> cache{};
+    return cache;
+  }
 }
 
 namespace art {
@@ -44,16 +49,26 @@ namespace art {
     return ti_->name();
   }
 
-  string
+  string const&
   TypeID::className() const
   {
+    // A per-thread front cache keyed by type_info address avoids
+    // computing the hash code, which is a hash of the mangled name.
+    // Since a type may have more than one type_info object, a miss
+    // falls back to the shared cache.
+    thread_local unordered_map<type_info const*, string const*> seen{};
+    if (auto it = seen.find(ti_); it != seen.end()) {
+      return *it->second;
+    }
     auto hash_code = typeInfo().hash_code();
-    std::lock_guard sentry{cache_mutex};
-    auto entry = name_cache.find(hash_code);
-    if (entry == name_cache.end()) {
-      entry =
-        name_cache.emplace(hash_code, uniform_type_name(typeInfo())).first;
+    auto& cache = name_cache();
+    auto entry = cache.find(hash_code);
+    if (entry == cache.end()) {
+      // Another thread may insert the same name first, in which case
+      // its entry is used.
+      entry = cache.emplace(hash_code, uniform_type_name(typeInfo())).first;
     }
+    seen.emplace(ti_, &entry->second);
     return entry->second;
   }
 
@@ -33,7 +33,9 @@ namespace art {
 
     std::type_info const& typeInfo() const;
     char const* name() const;
-    std::string className() const;
+    // The name is computed once per type and interned: the reference
+    // remains valid for the lifetime of the program.
+    std::string const& className() const;
     std::string friendlyClassName() const;
     bool operator<(TypeID const&) const;
     bool operator==(TypeID const&) const;
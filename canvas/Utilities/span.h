@@ -0,0 +1,101 @@
+#ifndef canvas_Utilities_span_h
+#define canvas_Utilities_span_h
+// vim: set sw=2 expandtab :
+
+// span<T>: a non-owning view of a contiguous sequence of objects of
+// type T, as std::span<T> in C++20.  The view is invalidated by any
+// operation that invalidates pointers to the viewed objects.
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace art {
+
+  template <typename T>
+  class span {
+  public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+    using const_iterator = T*;
+
+    constexpr span() noexcept = default;
+    constexpr span(T* const data, size_type const size) noexcept
+      : data_{data}, size_{size}
+    {}
+    constexpr span(T* const begin, T* const end) noexcept
+      : data_{begin}, size_(end - begin)
+    {}
+
+    constexpr iterator
+    begin() const noexcept
+    {
+      return data_;
+    }
+    constexpr iterator
+    end() const noexcept
+    {
+      return data_ + size_;
+    }
+    constexpr const_iterator
+    cbegin() const noexcept
+    {
+      return begin();
+    }
+    constexpr const_iterator
+    cend() const noexcept
+    {
+      return end();
+    }
+
+    constexpr pointer
+    data() const noexcept
+    {
+      return data_;
+    }
+    constexpr size_type
+    size() const noexcept
+    {
+      return size_;
+    }
+    constexpr bool
+    empty() const noexcept
+    {
+      return size_ == 0;
+    }
+
+    constexpr reference
+    operator[](size_type const i) const
+    {
+      assert(i < size_);
+      return data_[i];
+    }
+    constexpr reference
+    front() const
+    {
+      assert(!empty());
+      return data_[0];
+    }
+    constexpr reference
+    back() const
+    {
+      assert(!empty());
+      return data_[size_ - 1];
+    }
+
+  private:
+    T* data_{nullptr};
+    size_type size_{0};
+  };
+
+} // namespace art
+
+#endif /* canvas_Utilities_span_h */
+
+// Local Variables:
+// mode: c++
+// End:
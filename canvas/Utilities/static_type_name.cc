@@ -0,0 +1,27 @@
+#include "canvas/Utilities/static_type_name.h"
+// vim: set sw=2 expandtab :
+
+std::string
+art::detail::instantiation_name(
+  std::string_view const tmpl,
+  std::initializer_list<std::string const*> const args)
+{
+  std::size_t size{tmpl.size() + 3};
+  for (auto const* arg : args) {
+    size += arg->size() + 1;
+  }
+  std::string result;
+  result.reserve(size);
+  result += tmpl;
+  char separator{'<'};
+  for (auto const* arg : args) {
+    result += separator;
+    result += *arg;
+    separator = ',';
+  }
+  if (result.back() == '>') {
+    result += ' ';
+  }
+  result += '>';
+  return result;
+}
@@ -0,0 +1,271 @@
+#ifndef canvas_Utilities_static_type_name_h
+#define canvas_Utilities_static_type_name_h
+// vim: set sw=2 expandtab :
+
+////////////////////////////////////////////////////////////////////////
+//
+// static_type_name<T>(), static_friendly_name<T>(): the uniform type
+// name (see uniform_type_name.h) and the friendly name (see
+// FriendlyName.h) of a type known at compile time.
+//
+// The names are formed from the type itself, once per type, and are
+// returned by reference.  Where has_static_type_name_v<T> is true, no
+// demangling is done: the name is composed from those of the template
+// arguments of the type.  This is the case for
+//
+//   - the fundamental types;
+//   - class and enumeration types that are not template instantiations,
+//     are not in an anonymous namespace, and are not in namespace std;
+//   - std::string, and the instantiations of std::vector, std::pair,
+//     std::map and std::set with default allocators and comparators;
+//   - the instantiations of art::Wrapper, art::Ptr, art::PtrVector and
+//     art::Assns (specialized in their own headers);
+//
+// if all their template arguments are themselves of one of these kinds.
+// The names of all other types are obtained from uniform_type_name().
+//
+// The name of a further class template may be provided by specializing
+// static_type_name_traits for its instantiations, as is done below.
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "canvas/Utilities/FriendlyName.h"
+#include "canvas/Utilities/uniform_type_name.h"
+
+#include <initializer_list>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace art {
+
+  namespace detail {
+
+    template <typename T>
+    constexpr std::string_view
+    fundamental_type_name()
+    {
+      if constexpr (std::is_same_v<T, void>) {
+        return "void";
+      } else if constexpr (std::is_same_v<T, bool>) {
+        return "bool";
+      } else if constexpr (std::is_same_v<T, char>) {
+        return "char";
+      } else if constexpr (std::is_same_v<T, signed char>) {
+        return "signed char";
+      } else if constexpr (std::is_same_v<T, unsigned char>) {
+        return "unsigned char";
+      } else if constexpr (std::is_same_v<T, short>) {
+        return "short";
+      } else if constexpr (std::is_same_v<T, unsigned short>) {
+        return "unsigned short";
+      } else if constexpr (std::is_same_v<T, int>) {
+        return "int";
+      } else if constexpr (std::is_same_v<T, unsigned int>) {
+        return "unsigned int";
+      } else if constexpr (std::is_same_v<T, long>) {
+        return "long";
+      } else if constexpr (std::is_same_v<T, unsigned long>) {
+        return "unsigned long";
+      } else if constexpr (std::is_same_v<T, long long>) {
+        return "Long64_t";
+      } else if constexpr (std::is_same_v<T, unsigned long long>) {
+        return "ULong64_t";
+      } else if constexpr (std::is_same_v<T, float>) {
+        return "float";
+      } else if constexpr (std::is_same_v<T, double>) {
+        return "double";
+      } else if constexpr (std::is_same_v<T, long double>) {
+        return "long double";
+      } else {
+        return {};
+      }
+    }
+
+    // The name of T as written by the compiler in the signature of
+    // this function, or an empty view if the compiler is not known to
+    // write it in a usable form.
+    template <typename T>
+    constexpr std::string_view
+    compiler_type_name()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      std::string_view const signature{__PRETTY_FUNCTION__};
+      // GCC: "... [with T = ns::A; ...]"; Clang: "... [T = ns::A]".
+      auto b = signature.find("[with T = ");
+      if (b != std::string_view::npos) {
+        b += 10;
+      } else if ((b = signature.find("[T = ")) != std::string_view::npos) {
+        b += 5;
+      } else {
+        return {};
+      }
+      auto const e = signature.find_first_of(";]", b);
+      if (e == std::string_view::npos) {
+        return {};
+      }
+      return signature.substr(b, e - b);
+#else
+      return {};
+#endif
+    }
+
+    // For class and enumeration types whose names are spelled the same
+    // way by the compiler and by uniform_type_name.  The names of
+    // template instantiations, cv-qualified types and types in
+    // anonymous namespaces are spelled differently, as may be those of
+    // the types in namespace std.
+    template <typename T>
+    constexpr std::string_view
+    class_type_name()
+    {
+      if constexpr (std::is_class_v<T> || std::is_enum_v<T>) {
+        constexpr auto name = compiler_type_name<T>();
+        if (name.empty() || name.find_first_of("<>()[]{}*&, ") !=
+                              std::string_view::npos ||
+            name.substr(0, 5) == "std::") {
+          return {};
+        }
+        return name;
+      } else {
+        return {};
+      }
+    }
+
+    template <typename T>
+    constexpr std::string_view
+    static_leaf_name()
+    {
+      constexpr auto name = fundamental_type_name<T>();
+      if constexpr (name.empty()) {
+        return class_type_name<T>();
+      } else {
+        return name;
+      }
+    }
+
+    // "tmpl<arg1,arg2...>", with a space between consecutive '>'.
+    std::string instantiation_name(
+      std::string_view tmpl,
+      std::initializer_list<std::string const*> args);
+
+  } // namespace detail
+
+  template <typename T>
+  std::string const& static_type_name();
+
+  template <typename T>
+  struct static_type_name_traits {
+    static constexpr bool is_static{!detail::static_leaf_name<T>().empty()};
+    static std::string
+    name()
+    {
+      if constexpr (is_static) {
+        return std::string{detail::static_leaf_name<T>()};
+      } else {
+        return uniform_type_name(typeid(T));
+      }
+    }
+  };
+
+  template <typename T>
+  constexpr bool has_static_type_name_v{
+    static_type_name_traits<T>::is_static};
+
+  namespace detail {
+    // A convenient base for specializations of static_type_name_traits
+    // for the instantiations of a class template.
+    template <typename... Args>
+    struct static_template_name_traits {
+      static constexpr bool is_static{(has_static_type_name_v<Args> && ...)};
+      static std::string
+      name_of(std::string_view const tmpl)
+      {
+        return instantiation_name(tmpl, {&static_type_name<Args>()...});
+      }
+    };
+  }
+
+  template <typename T>
+  std::string const&
+  static_type_name()
+  {
+    static std::string const name{static_type_name_traits<T>::name()};
+    return name;
+  }
+
+  template <typename T>
+  std::string const&
+  static_friendly_name()
+  {
+    static std::string const name{
+      friendlyname::friendlyName(static_type_name<T>())};
+    return name;
+  }
+
+  template <>
+  struct static_type_name_traits<std::string> {
+    static constexpr bool is_static{true};
+    static std::string
+    name()
+    {
+      return "std::string";
+    }
+  };
+
+  template <typename T>
+  struct static_type_name_traits<std::vector<T>>
+    : detail::static_template_name_traits<T> {
+    static std::string
+    name()
+    {
+      return detail::static_template_name_traits<T>::name_of(
+        "std::vector");
+    }
+  };
+
+  template <typename T, typename U>
+  struct static_type_name_traits<std::pair<T, U>>
+    : detail::static_template_name_traits<T, U> {
+    static std::string
+    name()
+    {
+      return detail::static_template_name_traits<T, U>::name_of(
+        "std::pair");
+    }
+  };
+
+  template <typename K, typename V>
+  struct static_type_name_traits<std::map<K, V>>
+    : detail::static_template_name_traits<K, V> {
+    static std::string
+    name()
+    {
+      return detail::static_template_name_traits<K, V>::name_of(
+        "std::map");
+    }
+  };
+
+  template <typename T>
+  struct static_type_name_traits<std::set<T>>
+    : detail::static_template_name_traits<T> {
+    static std::string
+    name()
+    {
+      return detail::static_template_name_traits<T>::name_of(
+        "std::set");
+    }
+  };
+
+} // namespace art
+
+#endif /* canvas_Utilities_static_type_name_h */
+
+// Local Variables:
+// mode: c++
+// End:
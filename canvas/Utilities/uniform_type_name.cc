@@ -1,32 +1,137 @@
 #include "canvas/Utilities/uniform_type_name.h"
 
-#include "cetlib/replace_all.h"
-
-#include <regex>
+#include <algorithm>
+#include <cstring>
 #include <string>
+#include <string_view>
+
+// Each of the rewriting steps below is done in place, without regular
+// expressions: most are a single scan of the name that writes its
+// output over its input.  The name is only reallocated if it must grow
+// (when ">>" becomes "> >").  The steps, and their order, are those of
+// the original implementation based on regular expressions, whose
+// output is reproduced exactly.
+
+using namespace std::string_view_literals;
 
 namespace {
-  /// \fn reformat.
+
+  constexpr auto npos = std::string::npos;
+
+  bool
+  is_digit(char const c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  bool
+  is_identifier_char(char const c)
+  {
+    return is_digit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           c == '_';
+  }
+
+  bool
+  is_space(char const c)
+  {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+  }
+
+  bool
+  starts_with(std::string const& name,
+              std::size_t const pos,
+              std::string_view const prefix)
+  {
+    return name.compare(pos, prefix.size(), prefix) == 0;
+  }
+
+  /// \fn compact.
   ///
-  /// \brief Reformat the input string according to the provided regex
-  /// and format string.
+  /// \brief Rewrite the name in place, from left to right.
   ///
-  /// \param[in,out] input The string to be manipulated.
+  /// \param[in,out] name The string to be manipulated.
   ///
-  /// \param[in] exp The regular expression to be (repeatedly) applied.
+  /// \param[in] rewrite Called at each position of the name not yet
+  /// consumed, with the name, that position (which it may advance),
+  /// and the output so far (whose end it may extend, as long as it does
+  /// not pass the position).  It returns false if it did nothing, in
+  /// which case the character at the position is copied to the output.
+  template <typename Rewrite>
+  void
+  compact(std::string& name, Rewrite rewrite)
+  {
+    std::size_t in{};
+    std::size_t out{};
+    while (in != name.size()) {
+      if (!rewrite(name, in, out)) {
+        name[out++] = name[in++];
+      }
+    }
+    name.resize(out);
+  }
+
+  /// \fn replaceAllShorter.
   ///
-  /// \param[format] format The specified format string for the
-  /// replacement.
+  /// \brief Replace each occurrence of 'from', from left to right, by
+  /// the no-longer 'to'.
   void
-  reformat(std::string& input, std::regex const& exp, std::string const& format)
+  replaceAllShorter(std::string& name,
+                    std::string_view const from,
+                    std::string_view const to)
   {
-    while (1) {
-      std::string const formatted = std::regex_replace(input, exp, format);
-      if (formatted == input) {
-        break;
-      } else {
-        input = formatted;
+    auto pos = name.find(from);
+    if (pos == npos) {
+      return;
+    }
+    compact(name, [&pos, from, to](std::string& s, auto& in, auto& out) {
+      if (in != pos) {
+        return false;
       }
+      s.replace(out, to.size(), to);
+      out += to.size();
+      in += from.size();
+      pos = s.find(from, in);
+      return true;
+    });
+  }
+
+  /// \fn separateAngleBrackets.
+  ///
+  /// \brief Replace each ">>", from left to right, by "> >".
+  ///
+  /// Within a run of '>', a space thus follows each character at an
+  /// even offset from the start of the run, other than the last one.
+  /// The name is rewritten from its end, so that nothing is overwritten
+  /// before it is read.
+  void
+  separateAngleBrackets(std::string& name)
+  {
+    std::size_t count{};
+    for (auto pos = name.find(">>"sv); pos != npos;
+         pos = name.find(">>"sv, pos + 2)) {
+      ++count;
+    }
+    if (count == 0) {
+      return;
+    }
+    auto in = name.size();
+    name.resize(in + count);
+    auto out = name.size();
+    char next{};
+    std::size_t runStart{};
+    while (out != in) {
+      char const c = name[--in];
+      if (c == '>' && next != '>') {
+        runStart = in;
+        while (runStart != 0 && name[runStart - 1] == '>') {
+          --runStart;
+        }
+      }
+      if (c == '>' && next == '>' && (in - runStart) % 2 == 0) {
+        name[--out] = ' ';
+      }
+      name[--out] = c;
+      next = c;
     }
   }
 
@@ -41,19 +146,18 @@ namespace {
   /// string. Include leading comma if appropriate and trailing open
   /// angled bracket for template instantiations.
   void
-  removeParameter(std::string& name, std::string const& toRemove)
+  removeParameter(std::string& name, std::string_view const toRemove)
   {
     auto const asize = toRemove.size();
     auto const initDepth = (toRemove.back() == '<') ? 1 : 0;
-    if (asize == 0ul) {
-      return;
-    }
     char const* const delimiters = "<>";
-    auto index = std::string::npos;
-    while ((index = name.find(toRemove)) != std::string::npos) {
+    auto index = npos;
+    std::size_t from{};
+    while ((index = name.find(toRemove, from)) != npos) {
       int depth = initDepth;
       auto inx = index + asize;
-      while ((inx = name.find_first_of(delimiters, inx)) != std::string::npos) {
+      bool removed{false};
+      while ((inx = name.find_first_of(delimiters, inx)) != npos) {
         if (name[inx] == '<') {
           ++depth;
         } else {
@@ -62,11 +166,18 @@ namespace {
             if (name[index] == ' ' && (index == 0 || name[index - 1] != '>')) {
               name.erase(index, 1);
             }
+            removed = true;
             break;
           }
         }
         ++inx;
       }
+      if (!removed) {
+        // The parameter is not closed.
+        return;
+      }
+      // An occurrence may now straddle the point of removal.
+      from = index < asize ? 0 : index - asize + 1;
     }
   }
 
@@ -79,13 +190,18 @@ namespace {
   void
   constBeforeIdentifier(std::string& name)
   {
-    std::string const toBeMoved(" const");
+    constexpr auto toBeMoved = " const"sv;
+    constexpr auto moved = "const "sv;
     auto const asize = toBeMoved.size();
-    auto index = std::string::npos;
-    while ((index = name.find(toBeMoved)) != std::string::npos) {
-      name.erase(index, asize);
+    auto index = npos;
+    std::size_t from{};
+    while ((index = name.find(toBeMoved, from)) != npos) {
+      // Find the start of the type, if any, to which the qualifier
+      // applies.
       int depth = 0;
-      for (std::string::size_type inx = index - 1; inx > 0; --inx) {
+      std::string::size_type start{};
+      for (std::string::size_type inx = index - 1; index != 0 && inx > 0;
+           --inx) {
         char const c = name[inx];
         if (c == '>') {
           ++depth;
@@ -94,10 +210,19 @@ namespace {
             --depth;
           }
         } else if (c == '<' || c == ',') {
-          name.insert(inx + 1, "const ");
+          start = inx + 1;
           break;
         }
       }
+      if (start == 0) {
+        name.erase(index, asize);
+        from = index < asize ? 0 : index - asize + 1;
+        continue;
+      }
+      // "<type> const" -> "const <type>", without changing the length.
+      std::memmove(&name[start + asize], &name[start], index - start);
+      name.replace(start, asize, moved);
+      from = start;
     }
   }
 
@@ -136,83 +261,182 @@ namespace {
   translateInlineNamespace(std::string& name)
   {
     // libc++/libstdc++ std::ABI_TAG -> std::
-    {
-      static std::regex const ns_regex("std::__([[:digit:]]+|cxx11)::");
-      static std::string const ns_format("std::");
-      reformat(name, ns_regex, ns_format);
+    //
+    // The length of an inline namespace ("__1::" or "__cxx11::") that
+    // starts at pos, or zero.
+    auto inline_namespace = [](std::string const& s, std::size_t const pos) {
+      if (!starts_with(s, pos, "__"sv)) {
+        return std::size_t{};
+      }
+      auto end = pos + 2;
+      if (starts_with(s, end, "cxx11"sv)) {
+        end += 5;
+      } else {
+        while (end != s.size() && is_digit(s[end])) {
+          ++end;
+        }
+        if (end == pos + 2) {
+          return std::size_t{};
+        }
+      }
+      return starts_with(s, end, "::"sv) ? end + 2 - pos : std::size_t{};
+    };
+    if (name.find("std::__"sv) != npos) {
+      compact(name, [&inline_namespace](std::string& s, auto& in, auto& out) {
+        if (!starts_with(s, in, "std::"sv)) {
+          return false;
+        }
+        auto const length = inline_namespace(s, in + 5);
+        if (length == 0) {
+          return false;
+        }
+        s.replace(out, 5, "std::"sv);
+        out += 5;
+        in += 5 + length;
+        // "std::__1::__2::" -> "std::"
+        for (std::size_t more{}; (more = inline_namespace(s, in)) != 0;) {
+          in += more;
+        }
+        return true;
+      });
     }
 
     // Apply Itanium abbreviations
     // FIXME: If the need arises, may need to apply other abbreviations:
     // http://mentorembedded.github.io/cxx-abi/abi.html#mangling-compression
-    cet::replace_all(
-      name,
-      "std::basic_string<char, std::char_traits<char>, std::allocator<char> >",
-      "std::string");
-    cet::replace_all(
-      name, "std::basic_string<char, std::char_traits<char> >", "std::string");
+    replaceAllShorter(name,
+                      "std::basic_string<char, std::char_traits<char>, "
+                      "std::allocator<char> >"sv,
+                      "std::string"sv);
+    replaceAllShorter(name,
+                      "std::basic_string<char, std::char_traits<char> >"sv,
+                      "std::string"sv);
+  }
+
+  /// \fn basicStringToString.
+  ///
+  /// \brief Replace "std::basic_string<char>", and any whitespace that
+  /// follows it, by "std::string".
+  void
+  basicStringToString(std::string& name)
+  {
+    constexpr auto basic_string = "std::basic_string<char>"sv;
+    constexpr auto string = "std::string"sv;
+    if (name.find(basic_string) == npos) {
+      return;
+    }
+    compact(name, [basic_string, string](std::string& s, auto& in, auto& out) {
+      if (!starts_with(s, in, basic_string)) {
+        return false;
+      }
+      s.replace(out, string.size(), string);
+      out += string.size();
+      in += basic_string.size();
+      while (in != s.size() && is_space(s[in])) {
+        ++in;
+      }
+      return true;
+    });
+  }
+
+  /// \fn removeSpacesBeforeAngleBracket.
+  ///
+  /// \brief Remove the spaces between an identifier and a following
+  /// '>'.
+  void
+  removeSpacesBeforeAngleBracket(std::string& name)
+  {
+    if (name.find(" >"sv) == npos) {
+      return;
+    }
+    compact(name, [](std::string& s, auto& in, auto& out) {
+      if (s[in] != ' ' || out == 0 || !is_identifier_char(s[out - 1])) {
+        return false;
+      }
+      auto const end = s.find_first_not_of(' ', in);
+      if (end == npos || s[end] != '>') {
+        return false;
+      }
+      in = end;
+      return true;
+    });
+  }
+
+  /// \fn removeIntegerSuffixes.
+  ///
+  /// \brief Remove the u or l suffixes of the integers that are
+  /// template arguments.
+  void
+  removeIntegerSuffixes(std::string& name)
+  {
+    compact(name, [](std::string& s, auto& in, auto& out) {
+      if (s[in] != '<' && s[in] != ',') {
+        return false;
+      }
+      auto digits_end = in + 1;
+      while (digits_end != s.size() && is_digit(s[digits_end])) {
+        ++digits_end;
+      }
+      if (digits_end == in + 1 || digits_end == s.size() ||
+          (s[digits_end] != 'u' && s[digits_end] != 'l')) {
+        return false;
+      }
+      auto suffix_end = digits_end + 1;
+      while (suffix_end != s.size() && s[suffix_end] == 'l') {
+        ++suffix_end;
+      }
+      if (suffix_end == s.size() ||
+          (s[suffix_end] != ',' && s[suffix_end] != '>')) {
+        return false;
+      }
+      // The name cannot contain a line terminator, which '.' would not
+      // have matched in the original regular expression.
+      while (in != digits_end) {
+        s[out++] = s[in++];
+      }
+      in = suffix_end;
+      return true;
+    });
   }
 }
 
 std::string
 art::uniform_type_name(std::string name)
 {
-  using namespace std::string_literals;
   // We must use the same conventions previously used by Reflex.
   // The order is important.
 
   // Translate any inlined namespace
   translateInlineNamespace(name);
 
-  // We must change std::__cxx11:: -> std:: for all type names. This
-  // should not have implications for I/O because ROOT stores the data
-  // that STL objects represent rather than doing a "dumb serialization"
-  // of the class.
-  cet::replace_all(name, "std::__cxx11::"s, "std::"s);
-  // According to a report from Chris Jones, Apple Clang has a similar
-  // issue with std::__1.
-  cet::replace_all(name, "std::__1::"s, "std::"s);
-
   // No space after comma.
-  cet::replace_all(name, ", "s, ","s);
+  replaceAllShorter(name, ", "sv, ","sv);
   // No space before opening square bracket.
-  cet::replace_all(name, " ["s, "["s);
+  replaceAllShorter(name, " ["sv, "["sv);
   // Strip default allocator.
-  removeParameter(name, ",std::allocator<"s);
+  removeParameter(name, ",std::allocator<"sv);
   // Strip default comparator.
-  removeParameter(name, ",std::less<"s);
+  removeParameter(name, ",std::less<"sv);
   // Strip char traits.
-  removeParameter(name, ",std::char_traits<"s);
+  removeParameter(name, ",std::char_traits<"sv);
   // std::basic_string<char> -> std::string
-  {
-    static std::regex const bs_regex("std::basic_string<char>\\s*"s);
-    reformat(name, bs_regex, "std::string"s);
-  }
+  basicStringToString(name);
   // Put const qualifier before identifier.
   constBeforeIdentifier(name);
 
   // No spaces between template brakets and arguments
-  // FIXME?: need a regex because just stripping the spaces
-  // can cause subsequent ">>" removal fail...
-  {
-    static std::regex const bk_regex("([_a-zA-Z0-9])( +)>");
-    static std::string const bk_format("$1>");
-    reformat(name, bk_regex, bk_format);
-  }
+  removeSpacesBeforeAngleBracket(name);
 
   // No consecutive '>'.
   //
   // FIXME: The first time we see a type with e.g. operator>> as a
   // template argument, we could have a problem.
-  cet::replace_all(name, ">>"s, "> >"s);
+  separateAngleBrackets(name);
   // No u or l qualifiers for integers.
-  {
-    static std::regex const ul_regex("(.*[<,][0-9]+)[ul]l*([,>].*)"s);
-    reformat(name, ul_regex, "$1$2"s);
-  }
+  removeIntegerSuffixes(name);
   // For ROOT 6 and beyond.
-  cet::replace_all(name, "unsigned long long"s, "ULong64_t"s);
-  cet::replace_all(name, "long long"s, "Long64_t"s);
+  replaceAllShorter(name, "unsigned long long"sv, "ULong64_t"sv);
+  replaceAllShorter(name, "long long"sv, "Long64_t"sv);
   // Done.
   return name;
 }
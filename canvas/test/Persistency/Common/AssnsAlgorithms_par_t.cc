@@ -0,0 +1,178 @@
+#define BOOST_TEST_MODULE (AssnsAlgorithms_par_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/AssnsAlgorithms.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace art;
+
+namespace {
+
+  ProductID const tracksID{1};
+  ProductID const hitsID{2};
+
+  constexpr std::size_t n_tracks{1000};
+
+  // Track k has k % 7 hits, of keys 10 * k + i; track 3 is not
+  // associated.
+  std::vector<std::pair<std::size_t, std::size_t>>
+  track_hits()
+  {
+    std::vector<std::pair<std::size_t, std::size_t>> result;
+    for (std::size_t k{}; k != n_tracks; ++k) {
+      for (std::size_t i{}; k != 3 && i != k % 7; ++i) {
+        result.emplace_back(k, 10 * k + i);
+      }
+    }
+    return result;
+  }
+
+  std::size_t
+  expected_sum(std::size_t const k)
+  {
+    auto const n = k == 3 ? 0 : k % 7;
+    return n * 10 * k + n * (n - 1) / 2;
+  }
+
+  template <typename A>
+  A
+  make_assns(bool const shuffled)
+  {
+    auto pairs = track_hits();
+    if (shuffled) {
+      std::shuffle(pairs.begin(), pairs.end(), std::mt19937{42});
+    }
+    A result;
+    for (auto const& [track, hit] : pairs) {
+      Ptr<int> const left{tracksID, track, nullptr};
+      Ptr<float> const right{hitsID, hit, nullptr};
+      if constexpr (std::is_same_v<A, Assns<int, float>>) {
+        result.addSingle(left, right);
+      } else {
+        result.addSingle(left, right, static_cast<short>(hit % 10));
+      }
+    }
+    return result;
+  }
+
+  template <typename Rights>
+  std::size_t
+  sum_of_keys(Rights const& rights)
+  {
+    std::size_t result{};
+    for (auto const& right : rights) {
+      result += right.key();
+    }
+    return result;
+  }
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(AssnsAlgorithms_par_t)
+
+BOOST_AUTO_TEST_CASE(contiguous_groups)
+{
+  auto const assns = make_assns<Assns<int, float, short>>(false);
+  std::vector<std::size_t> sums(n_tracks);
+  std::vector<std::atomic<unsigned>> calls(n_tracks);
+  for_each_group_with_left_par(assns,
+                               [&](Ptr<int> const& track, auto hits) {
+                                 sums[track.key()] = sum_of_keys(hits);
+                                 ++calls[track.key()];
+                               });
+  for (std::size_t k{}; k != n_tracks; ++k) {
+    BOOST_TEST(sums[k] == expected_sum(k));
+    BOOST_TEST(calls[k] == (k == 3 || k % 7 == 0 ? 0u : 1u));
+  }
+
+  std::atomic<std::size_t> total{};
+  std::atomic<unsigned> groups{};
+  for_each_group_par(assns, [&](auto hits) {
+    total += sum_of_keys(hits);
+    ++groups;
+  });
+  std::size_t expected_total{};
+  unsigned expected_groups{};
+  for (std::size_t k{}; k != n_tracks; ++k) {
+    expected_total += expected_sum(k);
+    expected_groups += expected_sum(k) != 0 || k % 7 == 1;
+  }
+  BOOST_TEST(total == expected_total);
+  BOOST_TEST(groups == expected_groups);
+}
+
+BOOST_AUTO_TEST_CASE(non_contiguous_groups)
+{
+  auto const assns = make_assns<Assns<int, float>>(true);
+  std::vector<std::size_t> sums(n_tracks);
+  std::vector<std::atomic<unsigned>> calls(n_tracks);
+  std::vector<char> in_order(n_tracks, true);
+  for_each_group_indexed_par(assns, [&](Ptr<int> const& track, auto hits) {
+    auto const rows = hits.rows();
+    in_order[track.key()] = std::is_sorted(rows.begin(), rows.end());
+    sums[track.key()] = sum_of_keys(hits);
+    ++calls[track.key()];
+  });
+  for (std::size_t k{}; k != n_tracks; ++k) {
+    BOOST_TEST(sums[k] == expected_sum(k));
+    BOOST_TEST(calls[k] == (k == 3 || k % 7 == 0 ? 0u : 1u));
+    // The hits are in the order of the Assns.
+    BOOST_TEST(in_order[k]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(transform)
+{
+  auto const assns = make_assns<Assns<int, float, short>>(true);
+  auto const sums = transform_groups(assns, [](auto const&, auto hits) {
+    return sum_of_keys(hits);
+  });
+  BOOST_TEST_REQUIRE(sums.size() == n_tracks);
+  for (std::size_t k{}; k != sums.size(); ++k) {
+    BOOST_TEST(sums[k] == expected_sum(k));
+  }
+
+  // With the data, through the rows of the associations.
+  AssnsIndex const index{assns};
+  auto const data = transform_groups(assns, [&](auto const& track, auto) {
+    auto const d = index.leftData(track);
+    return std::accumulate(d.begin(), d.end(), 0);
+  });
+  BOOST_TEST(data[6] == 15);
+  BOOST_TEST(data[3] == 0);
+
+  BOOST_TEST(transform_groups(Assns<int, float>{}, [](auto const&, auto) {
+               return 1;
+             }).empty());
+}
+
+BOOST_AUTO_TEST_CASE(several_left_products)
+{
+  auto assns = make_assns<Assns<int, float>>(false);
+  assns.addSingle(Ptr<int>{ProductID{7}, 0, nullptr},
+                  Ptr<float>{hitsID, 0, nullptr});
+  BOOST_CHECK_THROW(
+    transform_groups(assns, [](auto const&, auto) { return 1; }), Exception);
+
+  // The other variants group the Ptrs of each product separately.
+  std::atomic<unsigned> groups{};
+  for_each_group_indexed_par(assns,
+                             [&](auto const&, auto) { ++groups; });
+  std::atomic<unsigned> contiguous_groups{};
+  for_each_group_par(assns, [&](auto) { ++contiguous_groups; });
+  BOOST_TEST(groups == contiguous_groups);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,193 @@
+#define BOOST_TEST_MODULE (AssnsIndex_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/AssnsIndex.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace art;
+
+namespace {
+
+  ProductID const hitsID{1};
+  ProductID const clustersID{2};
+  ProductID const tracksID{3};
+  ProductID const otherHitsID{4};
+
+  struct Fixture {
+    Fixture()
+    {
+      // Hit 2 is in no cluster; hit 1 is shared by clusters 0 and 2.
+      std::vector<std::pair<std::size_t, std::size_t>> const hitClusters{
+        {0, 0}, {1, 2}, {3, 1}, {1, 0}, {4, 2}, {5, 1}};
+      for (auto const& [h, c] : hitClusters) {
+        hitClusterAssns.addSingle(hit(h),
+                                  cluster(c),
+                                  "h" + std::to_string(h) + "c" +
+                                    std::to_string(c));
+      }
+      hitClusterAssns.addSingle(
+        Ptr<int>{otherHitsID, &otherHit, 0}, cluster(0), "other");
+
+      // Cluster 2 is in tracks 0 and 1.
+      std::vector<std::pair<std::size_t, std::size_t>> const clusterTracks{
+        {2, 1}, {0, 0}, {2, 0}, {1, 1}};
+      for (auto const& [c, t] : clusterTracks) {
+        clusterTrackAssns.addSingle(cluster(c), track(t));
+      }
+    }
+
+    Ptr<int>
+    hit(std::size_t const i) const
+    {
+      return {hitsID, &hits[i], i};
+    }
+    Ptr<float>
+    cluster(std::size_t const i) const
+    {
+      return {clustersID, &clusters[i], i};
+    }
+    Ptr<double>
+    track(std::size_t const i) const
+    {
+      return {tracksID, &tracks[i], i};
+    }
+
+    std::vector<int> const hits{0, 1, 2, 3, 4, 5};
+    int const otherHit{10};
+    std::vector<float> const clusters{0., 1., 2.};
+    std::vector<double> const tracks{0., 1.};
+    Assns<int, float, std::string> hitClusterAssns;
+    Assns<float, double> clusterTrackAssns;
+  };
+
+  template <typename Range>
+  auto
+  to_vector(Range const& r)
+  {
+    return std::vector(r.begin(), r.end());
+  }
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(AssnsIndex_t)
+
+BOOST_FIXTURE_TEST_CASE(forward, Fixture)
+{
+  AssnsIndex const index{hitClusterAssns};
+  BOOST_TEST(index.degreeOfLeft(hit(1)) == 2ull);
+  BOOST_TEST(index.degreeOfLeft(hit(2)) == 0ull);
+  BOOST_TEST(index.degreeOfLeft(Ptr<int>{}) == 0ull);
+  BOOST_TEST((to_vector(index.leftRows(hit(1))) ==
+              std::vector<std::size_t>{1, 3}));
+
+  // In the order of the Assns.
+  auto const clusters = index.rights(hit(1));
+  BOOST_TEST_REQUIRE(clusters.size() == 2ull);
+  BOOST_TEST((clusters[0] == cluster(2)));
+  BOOST_TEST((clusters[1] == cluster(0)));
+  BOOST_TEST((*(clusters.begin() + 1) == cluster(0)));
+  BOOST_TEST((clusters.end() - clusters.begin() == 2));
+  BOOST_TEST(index.rights(hit(2)).empty());
+
+  auto const data = index.leftData(hit(1));
+  BOOST_TEST((to_vector(data) == std::vector<std::string>{"h1c2", "h1c0"}));
+  BOOST_TEST(data.begin()->size() == 4ull);
+
+  // The key of an item is looked up in its own product only.
+  Ptr<int> const other{otherHitsID, &otherHit, 0};
+  BOOST_TEST(index.degreeOfLeft(other) == 1ull);
+  BOOST_TEST(index.leftRows(otherHitsID, 0).size() == 1ull);
+  BOOST_TEST(index.leftRows(otherHitsID, 1).empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(reverse, Fixture)
+{
+  AssnsIndex const index{hitClusterAssns};
+  BOOST_TEST(index.degreeOfRight(cluster(0)) == 3ull);
+  auto const hits = index.lefts(cluster(0));
+  Ptr<int> const other{otherHitsID, &otherHit, 0};
+  BOOST_TEST((to_vector(hits) == std::vector{hit(0), hit(1), other}));
+  BOOST_TEST((to_vector(index.rightData(cluster(1))) ==
+              std::vector<std::string>{"h3c1", "h5c1"}));
+  BOOST_TEST(index.rightRows(clustersID, 3).empty());
+  BOOST_TEST(index.rightRows(hitsID, 0).empty());
+
+  // Every association is found from both sides.
+  for (std::size_t row{}; row != hitClusterAssns.size(); ++row) {
+    auto const& [left, right] = hitClusterAssns[row];
+    auto const lrows = index.leftRows(left);
+    auto const rrows = index.rightRows(right);
+    BOOST_TEST(std::count(lrows.begin(), lrows.end(), row) == 1);
+    BOOST_TEST(std::count(rrows.begin(), rrows.end(), row) == 1);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(two_hops, Fixture)
+{
+  AssnsIndex const hitClusters{hitClusterAssns};
+  AssnsIndex const clusterTracks{clusterTrackAssns};
+
+  // The tracks of hit 1, through its clusters 2 and 0.
+  std::vector<Ptr<double>> tracks;
+  for (auto const& c : hitClusters.rights(hit(1))) {
+    for (auto const& t : clusterTracks.rights(c)) {
+      tracks.push_back(t);
+    }
+  }
+  BOOST_TEST((tracks == std::vector{track(1), track(0), track(0)}));
+
+  // The hits of track 1, through its clusters 2 and 1.
+  std::vector<Ptr<int>> hits;
+  for (auto const& c : clusterTracks.lefts(track(1))) {
+    auto const h = hitClusters.lefts(c);
+    hits.insert(hits.end(), h.begin(), h.end());
+  }
+  BOOST_TEST((hits == std::vector{hit(1), hit(4), hit(3), hit(5)}));
+}
+
+BOOST_FIXTURE_TEST_CASE(shared_indices, Fixture)
+{
+  AssnsIndex const a{hitClusterAssns};
+  AssnsIndex const b{hitClusterAssns};
+  BOOST_TEST(a.leftRows(hit(1)).data() == b.leftRows(hit(1)).data());
+  BOOST_TEST(a.rightRows(cluster(0)).data() ==
+             b.rightRows(cluster(0)).data());
+  BOOST_TEST(&hitClusterAssns.rightKeyIndex(clustersID) ==
+             &hitClusterAssns.rightKeyIndex(clustersID));
+
+  // A modification of the Assns rebuilds the indices.
+  hitClusterAssns.addSingle(hit(2), cluster(0), "h2c0");
+  BOOST_TEST(a.degreeOfLeft(hit(2)) == 1ull);
+  BOOST_TEST(a.degreeOfRight(cluster(0)) == 4ull);
+}
+
+BOOST_FIXTURE_TEST_CASE(concurrent_use, Fixture)
+{
+  AssnsIndex const index{hitClusterAssns};
+  std::vector<std::size_t> degrees(8);
+  std::vector<std::thread> threads;
+  for (std::size_t i{}; i != degrees.size(); ++i) {
+    threads.emplace_back([&, i] {
+      degrees[i] = index.degreeOfLeft(hit(i % hits.size())) +
+                   index.degreeOfRight(cluster(i % clusters.size()));
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (std::size_t i{}; i != degrees.size(); ++i) {
+    BOOST_TEST(degrees[i] ==
+               index.degreeOfLeft(hit(i % hits.size())) +
+                 index.degreeOfRight(cluster(i % clusters.size())));
+  }
+  BOOST_TEST(hitClusterAssns.leftKeyIndex(hitsID).size() == 6ull);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,230 @@
+#define BOOST_TEST_MODULE (Assns_bulk_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/EDProductGetter.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/PtrVector.h"
+#include "canvas/Persistency/Common/Wrapper.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/span.h"
+
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace art;
+
+namespace {
+
+  ProductID const aID{1};
+  ProductID const bID{2};
+
+  // Provides a product to the Ptrs that refer to it.
+  template <typename T>
+  class ProductGetter : public EDProductGetter {
+  public:
+    explicit ProductGetter(std::vector<T> items)
+      : wrapper_{std::make_unique<std::vector<T>>(std::move(items))}
+    {}
+
+  private:
+    EDProduct const*
+    getIt_() const override
+    {
+      return &wrapper_;
+    }
+
+    Wrapper<std::vector<T>> wrapper_;
+  };
+
+  // Provides the ID and the getter of a product, as a handle does.
+  template <typename T>
+  struct MockHandle {
+    ProductID
+    id() const
+    {
+      return pid;
+    }
+    EDProductGetter const*
+    productGetter() const
+    {
+      return &getter;
+    }
+    ProductID const pid;
+    ProductGetter<T> const getter;
+  };
+
+  // Counts its moves.
+  struct Data {
+    Data() = default;
+    explicit Data(std::string v) : value{std::move(v)} {}
+    Data(Data const&) = default;
+    Data(Data&& other) noexcept : value{std::move(other.value)}
+    {
+      ++moves;
+    }
+    Data& operator=(Data const&) = default;
+    Data&
+    operator=(Data&& other) noexcept
+    {
+      value = std::move(other.value);
+      ++moves;
+      return *this;
+    }
+    std::string value;
+    static inline unsigned moves{};
+  };
+
+}
+
+BOOST_AUTO_TEST_SUITE(Assns_bulk_t)
+
+BOOST_AUTO_TEST_CASE(keys)
+{
+  MockHandle<int> const ints{aID, ProductGetter{std::vector{10, 11, 12, 13}}};
+  std::vector<float> floats(8);
+  for (std::size_t i{}; i != floats.size(); ++i) {
+    floats[i] = 0.5f * i;
+  }
+  MockHandle<float> const handle{bID, ProductGetter{floats}};
+  std::vector<std::size_t> const leftKeys{0, 0, 3, 1};
+  unsigned const rightKeys[]{5, 2, 2, 7};
+
+  Assns<int, float> assns;
+  assns.reserve(8);
+  assns.addSingle(Ptr<int>{aID, 9, nullptr}, Ptr<float>{bID, 9, nullptr});
+  assns.addMany(ints,
+                span<std::size_t const>{leftKeys.data(), leftKeys.size()},
+                handle,
+                rightKeys);
+  BOOST_TEST_REQUIRE(assns.size() == 5ull);
+  for (std::size_t i{}; i != leftKeys.size(); ++i) {
+    auto const& [left, right] = assns[i + 1];
+    BOOST_TEST(left.id() == aID);
+    BOOST_TEST(left.key() == leftKeys[i]);
+    BOOST_TEST(right.id() == bID);
+    BOOST_TEST(right.key() == rightKeys[i]);
+    BOOST_TEST(right.productGetter() == &handle.getter);
+    // The items are resolved through the getters.
+    BOOST_TEST(*left == 10 + static_cast<int>(leftKeys[i]));
+    BOOST_TEST(*right == floats[rightKeys[i]]);
+  }
+  BOOST_TEST(assns.leftKeyIndex(aID).degree(0) == 2ull);
+
+  // The cached indices are rebuilt.
+  assns.addMany(std::pair{aID, ints.productGetter()},
+                std::vector{0},
+                std::pair{bID, handle.productGetter()},
+                std::vector{1});
+  BOOST_TEST(assns.leftKeyIndex(aID).degree(0) == 3ull);
+  BOOST_TEST(*assns[5].first == 10);
+  BOOST_TEST(*assns[5].second == 0.5f);
+}
+
+BOOST_AUTO_TEST_CASE(ptrs)
+{
+  std::vector<Ptr<int>> const lefts{Ptr<int>{aID, 0, nullptr},
+                                    Ptr<int>{aID, 1, nullptr}};
+  std::list<Ptr<float>> const rights{Ptr<float>{bID, 0, nullptr},
+                                     Ptr<float>{bID, 1, nullptr}};
+  Assns<int, float> assns;
+  assns.addMany(lefts, rights.front());
+  assns.addMany(lefts.back(), rights);
+  PtrVector<int> ptrVector;
+  ptrVector.push_back(lefts.front());
+  assns.addMany(ptrVector, rights.back());
+  BOOST_TEST_REQUIRE(assns.size() == 5ull);
+  BOOST_TEST((assns[2] == std::pair{lefts[1], rights.front()}));
+  BOOST_TEST((assns[4] == std::pair{lefts[0], rights.back()}));
+}
+
+BOOST_AUTO_TEST_CASE(data)
+{
+  std::vector<std::size_t> const leftKeys{0, 1, 2};
+  std::vector<std::size_t> const rightKeys{2, 1, 0};
+  EDProductGetter const getter;
+  std::pair const left{aID, &getter};
+  std::pair const right{bID, &getter};
+  Assns<int, float, Data> assns;
+  assns.reserve(6);
+
+  // Copied in.
+  std::vector<Data> const copied{Data{"a"}, Data{"b"}, Data{"c"}};
+  assns.addMany(left, leftKeys, right, rightKeys, copied);
+
+  // Moved in, element by element.
+  std::vector<Data> moved{Data{"d"}, Data{"e"}, Data{"f"}};
+  Data::moves = 0;
+  assns.addMany(left, leftKeys, right, rightKeys, std::move(moved));
+  BOOST_TEST(Data::moves == 3u);
+
+  // Moved in, by taking over the buffer.
+  Assns<int, float, Data> other;
+  std::vector<Data> taken{Data{"g"}, Data{"h"}};
+  auto const buffer = taken.data();
+  Data::moves = 0;
+  other.addMany(Ptr<int>{aID, 0, nullptr},
+                std::vector{Ptr<float>{bID, 0, nullptr},
+                            Ptr<float>{bID, 1, nullptr}},
+                std::move(taken));
+  BOOST_TEST(Data::moves == 0u);
+  BOOST_TEST(&other.data(0) == buffer);
+  other.addSingle(
+    Ptr<int>{aID, 1, nullptr}, Ptr<float>{bID, 2, nullptr}, Data{"i"});
+  BOOST_TEST(Data::moves > 0u);
+
+  BOOST_TEST_REQUIRE(assns.size() == 6ull);
+  BOOST_TEST(assns.data(1).value == "b");
+  BOOST_TEST(assns.data(4).value == "e");
+  BOOST_TEST(assns[4].second.key() == 1ull);
+  BOOST_TEST(other.data(2).value == "i");
+}
+
+BOOST_AUTO_TEST_CASE(getters)
+{
+  // The getter of a product may be given by a non-const pointer, of
+  // any type derived from EDProductGetter.
+  ProductGetter<int> ints{std::vector{10, 11}};
+  EDProductGetter getter;
+  Assns<int, float> assns;
+  assns.addMany(std::pair{aID, &ints},
+                std::vector{1},
+                std::pair{bID, &getter},
+                std::vector{0});
+  BOOST_TEST_REQUIRE(assns.size() == 1ull);
+  BOOST_TEST(assns[0].first.productGetter() == &ints);
+  BOOST_TEST(assns[0].second.productGetter() == &getter);
+  BOOST_TEST(*assns[0].first == 11);
+}
+
+BOOST_AUTO_TEST_CASE(mismatched_sizes)
+{
+  EDProductGetter const getter;
+  std::pair const left{aID, &getter};
+  std::pair const right{bID, &getter};
+  std::vector<std::size_t> const keys{0, 1};
+  std::vector<std::size_t> const fewerKeys{0};
+
+  Assns<int, float> assns;
+  BOOST_CHECK_THROW(assns.addMany(left, keys, right, fewerKeys),
+                    art::Exception);
+  BOOST_TEST(assns.size() == 0ull);
+
+  Assns<int, float, Data> withData;
+  BOOST_CHECK_THROW(
+    withData.addMany(left, keys, right, keys, std::vector{Data{"a"}}),
+    art::Exception);
+  std::vector<Data> const data{Data{"a"}};
+  BOOST_CHECK_THROW(withData.addMany(left, keys, right, keys, data),
+                    art::Exception);
+  BOOST_CHECK_THROW(withData.addMany(Ptr<int>{aID, 0, nullptr},
+                                     std::vector<Ptr<float>>{},
+                                     std::vector{Data{"b"}}),
+                    art::Exception);
+  BOOST_TEST(withData.size() == 0ull);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
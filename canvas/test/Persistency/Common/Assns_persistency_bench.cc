@@ -0,0 +1,151 @@
+// vim: set sw=2 expandtab :
+
+// Reports the memory used by, and the time taken to fill, the
+// persistent representation of an Assns of N associations, N given on
+// the command line (default: 10M), and the time taken to fill its
+// transient representation back from it (as on read), in the packed
+// layout and in the previous, unpacked, one.
+//
+// The left Ptrs refer to one product, four associations per item; the
+// right Ptrs alternate between two products.  For the unpacked layout,
+// the key of the last left Ptr is made too large to be packed.
+//
+// The heap usage is measured by counting the bytes allocated through
+// the global operator new.
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/AssnsBase.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+using namespace art;
+
+namespace {
+
+  std::atomic<long long> heap_bytes{};
+
+  // Each allocation is preceded by its size.
+  constexpr std::size_t header_size{alignof(std::max_align_t)};
+
+  void*
+  counted_alloc(std::size_t const n)
+  {
+    auto p = static_cast<char*>(std::malloc(n + header_size));
+    if (p == nullptr) {
+      throw std::bad_alloc{};
+    }
+    *reinterpret_cast<std::size_t*>(p) = n;
+    heap_bytes += n;
+    return p + header_size;
+  }
+
+  void
+  counted_free(void* const p) noexcept
+  {
+    if (p == nullptr) {
+      return;
+    }
+    auto const base = static_cast<char*>(p) - header_size;
+    heap_bytes -= *reinterpret_cast<std::size_t*>(base);
+    std::free(base);
+  }
+
+} // unnamed namespace
+
+void*
+operator new(std::size_t const n)
+{
+  return counted_alloc(n);
+}
+void*
+operator new[](std::size_t const n)
+{
+  return counted_alloc(n);
+}
+void
+operator delete(void* const p) noexcept
+{
+  counted_free(p);
+}
+void
+operator delete[](void* const p) noexcept
+{
+  counted_free(p);
+}
+void
+operator delete(void* const p, std::size_t) noexcept
+{
+  counted_free(p);
+}
+void
+operator delete[](void* const p, std::size_t) noexcept
+{
+  counted_free(p);
+}
+
+namespace {
+
+  using assns_t = Assns<int, float>;
+
+  double
+  ms_since(std::chrono::steady_clock::time_point const start)
+  {
+    return std::chrono::duration<double, std::milli>{
+      std::chrono::steady_clock::now() - start}
+      .count();
+  }
+
+  void
+  run(char const* const what, std::size_t const n, bool const packable)
+  {
+    assns_t assns;
+    for (std::size_t i{}; i != n; ++i) {
+      auto const left_key =
+        packable || i + 1 != n ? i / 4 : std::size_t{1} << 40;
+      assns.addSingle(Ptr<int>{ProductID{1}, left_key, nullptr},
+                      Ptr<float>{ProductID(2 + i % 2), i / 2, nullptr});
+    }
+    detail::AssnsBase& base = assns;
+
+    auto const before = heap_bytes.load();
+    auto start = std::chrono::steady_clock::now();
+    base.fill_from_transients();
+    auto const write_ms = ms_since(start);
+    auto const bytes = heap_bytes.load() - before;
+
+    start = std::chrono::steady_clock::now();
+    base.fill_transients();
+    auto const read_ms = ms_since(start);
+    if (assns.size() != n) {
+      std::abort();
+    }
+
+    std::cout << std::left << std::setw(10) << what << std::right
+              << std::setw(14) << bytes / (1024 * 1024) << std::setw(14)
+              << double(bytes) / n << std::setw(14) << write_ms
+              << std::setw(14) << read_ms << '\n';
+  }
+
+} // unnamed namespace
+
+int
+main(int argc, char** argv)
+{
+  std::size_t const n =
+    argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+  std::cout << n << " associations\n\n"
+            << std::fixed << std::setprecision(1) << std::left
+            << std::setw(10) << "" << std::right << std::setw(14)
+            << "heap [MiB]" << std::setw(14) << "B/assn" << std::setw(14)
+            << "write [ms]" << std::setw(14) << "read [ms]" << '\n';
+  run("unpacked", n, false);
+  run("packed", n, true);
+}
@@ -0,0 +1,235 @@
+#define BOOST_TEST_MODULE (IPRHelper_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/detail/AssnsKeyIndex.h"
+#include "canvas/Persistency/Common/detail/IPRHelper.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/Exception.h"
+#include "canvas/Utilities/InputTag.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace art;
+using detail::AssnsKeyIndex;
+
+namespace {
+
+  // Provides the one product it is given, whatever the tag.
+  class MockEvent {
+  public:
+    template <typename T>
+    class HandleT {
+    public:
+      bool
+      isValid() const
+      {
+        return product_ != nullptr;
+      }
+      T const&
+      operator*() const
+      {
+        return *product_;
+      }
+      std::shared_ptr<Exception const>
+      whyFailed() const
+      {
+        return std::make_shared<Exception const>(errors::ProductNotFound);
+      }
+
+    private:
+      friend class MockEvent;
+      T const* product_{nullptr};
+    };
+
+    explicit MockEvent(void const* product) : product_{product} {}
+
+    template <typename T>
+    void
+    getByLabel(InputTag const&, HandleT<T>& handle) const
+    {
+      handle.product_ = static_cast<T const*>(product_);
+    }
+
+  private:
+    void const* product_;
+  };
+
+  using assns_t = Assns<int, float, short>;
+  using helper_t = detail::IPRHelper<int,
+                                     float,
+                                     short,
+                                     std::vector<std::vector<short const*>>,
+                                     MockEvent>;
+  using assns_void_t = Assns<int, float>;
+  using helper_void_t = detail::IPRHelper<int, float, void, void, MockEvent>;
+
+  ProductID const aID{2};
+  ProductID const otherAID{5};
+  ProductID const bID{3};
+
+  struct Fixture {
+    Fixture()
+    {
+      // A 3 has no associations; the associations of the other A objects
+      // are interleaved.
+      std::vector<std::pair<std::size_t, std::size_t>> const pairs{
+        {1, 0}, {0, 1}, {1, 2}, {4, 3}, {0, 4}, {2, 5}};
+      for (auto const& [a, b] : pairs) {
+        assns.addSingle(Ptr<int>{aID, &as[a], a},
+                        Ptr<float>{bID, &bs[b], b},
+                        static_cast<short>(10 * b));
+        assnsVoid.addSingle(Ptr<int>{aID, &as[a], a},
+                            Ptr<float>{bID, &bs[b], b});
+      }
+      // An association of an A object of another product.
+      assns.addSingle(
+        Ptr<int>{otherAID, &other, 0}, Ptr<float>{bID, &bs[0], 0}, -1);
+    }
+
+    std::vector<int> const as{0, 1, 2, 3, 4};
+    int const other{10};
+    std::vector<float> const bs{0., 1., 2., 3., 4., 5.};
+    assns_t assns;
+    assns_void_t assnsVoid;
+    MockEvent const event{&assns};
+    MockEvent const eventVoid{&assnsVoid};
+  };
+
+  template <typename T>
+  std::vector<std::vector<T>>
+  sorted(std::vector<std::vector<T>> v)
+  {
+    for (auto& e : v) {
+      std::sort(e.begin(), e.end());
+    }
+    return v;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(IPRHelper_t)
+
+BOOST_AUTO_TEST_CASE(dense_key_index)
+{
+  auto constexpr npos = AssnsKeyIndex::npos;
+  AssnsKeyIndex const index{{1, 0, npos, 1, 3, 0}};
+  BOOST_TEST(index.size() == 5ull);
+  auto const rows0 = index.rows(0);
+  BOOST_TEST((std::vector(rows0.begin(), rows0.end()) ==
+              std::vector<std::size_t>{1, 5}));
+  auto const rows1 = index.rows(1);
+  BOOST_TEST((std::vector(rows1.begin(), rows1.end()) ==
+              std::vector<std::size_t>{0, 3}));
+  BOOST_TEST(index.degree(2) == 0ull);
+  BOOST_TEST(index.degree(3) == 1ull);
+  BOOST_TEST(index.degree(4) == 0ull);
+  BOOST_TEST(index.degree(npos) == 0ull);
+  BOOST_TEST(AssnsKeyIndex{}.degree(0) == 0ull);
+
+  std::vector<std::size_t> keys;
+  index.for_each_key([&keys](std::size_t const key, auto const rows) {
+    keys.insert(keys.end(), rows.size(), key);
+  });
+  BOOST_TEST((keys == std::vector<std::size_t>{0, 0, 1, 1, 3}));
+  AssnsKeyIndex{}.for_each_key([](auto...) { BOOST_FAIL("No keys."); });
+}
+
+BOOST_AUTO_TEST_CASE(sparse_key_index)
+{
+  AssnsKeyIndex const index{{1'000'000, 7, 1'000'000, AssnsKeyIndex::npos}};
+  BOOST_TEST(index.size() == 3ull);
+  auto const rows = index.rows(1'000'000);
+  BOOST_TEST((std::vector(rows.begin(), rows.end()) ==
+              std::vector<std::size_t>{0, 2}));
+  BOOST_TEST(index.degree(7) == 1ull);
+  BOOST_TEST(index.degree(8) == 0ull);
+  BOOST_TEST(index.degree(0) == 0ull);
+
+  std::vector<std::size_t> keys;
+  index.for_each_key([&keys](std::size_t const key, auto const rows) {
+    keys.insert(keys.end(), rows.size(), key);
+  });
+  BOOST_TEST((keys == std::vector<std::size_t>{7, 1'000'000, 1'000'000}));
+}
+
+BOOST_FIXTURE_TEST_CASE(by_key_and_by_address, Fixture)
+{
+  helper_t const finder{event, InputTag{"assns"}};
+
+  // By key: the A collection is product aID.
+  std::vector<std::vector<float const*>> byKey;
+  std::vector<std::vector<short const*>> byKeyData;
+  BOOST_TEST(!finder(as, aID, byKey, byKeyData));
+
+  // By address: the A collection is a sequence of pointers.
+  std::vector<int const*> view;
+  for (auto const& a : as) {
+    view.push_back(&a);
+  }
+  std::vector<std::vector<float const*>> byAddress;
+  std::vector<std::vector<short const*>> byAddressData;
+  BOOST_TEST(!finder(view, byAddress, byAddressData));
+
+  BOOST_TEST_REQUIRE(byKey.size() == as.size());
+  BOOST_TEST((sorted(byKey) == sorted(byAddress)));
+  BOOST_TEST((sorted(byKeyData) == sorted(byAddressData)));
+
+  // The associated items of an A object are in the order of the Assns.
+  BOOST_TEST((byKey[0] == std::vector{&bs[1], &bs[4]}));
+  BOOST_TEST((byKey[1] == std::vector{&bs[0], &bs[2]}));
+  BOOST_TEST(byKey[3].empty());
+  BOOST_TEST(*byKeyData[4][0] == 30);
+
+  // By key: Ptrs to A objects of one product.
+  std::vector<Ptr<int>> const ptrs{Ptr<int>{aID, &as[4], 4},
+                                   Ptr<int>{aID, &as[0], 0}};
+  std::vector<std::vector<float const*>> byPtrKey;
+  std::vector<std::vector<short const*>> byPtrKeyData;
+  BOOST_TEST(!finder(ptrs, byPtrKey, byPtrKeyData));
+  BOOST_TEST((byPtrKey[0] == byKey[4]));
+  BOOST_TEST((byPtrKey[1] == byKey[0]));
+}
+
+BOOST_FIXTURE_TEST_CASE(one_to_one, Fixture)
+{
+  helper_void_t const finder{eventVoid, InputTag{"assns"}};
+  std::vector<Ptr<float>> bColl;
+  // A 0 has two associated items.
+  BOOST_CHECK_THROW(finder(as, aID, bColl), Exception);
+
+  std::vector<Ptr<int>> const ptrs{Ptr<int>{aID, &as[2], 2},
+                                   Ptr<int>{aID, &as[3], 3}};
+  BOOST_TEST(!finder(ptrs, bColl));
+  BOOST_TEST_REQUIRE(bColl.size() == 2ull);
+  BOOST_TEST(bColl[0].key() == 5ull);
+  BOOST_TEST(bColl[1].isNull());
+}
+
+BOOST_FIXTURE_TEST_CASE(cached_indices, Fixture)
+{
+  auto const& index = assns.leftKeyIndex(aID);
+  BOOST_TEST(index.size() == 6ull);
+  BOOST_TEST(&assns.leftKeyIndex(aID) == &index);
+  BOOST_TEST(assns.leftKeyIndex(otherAID).size() == 1ull);
+
+  // A copy has its own indices, and a modification rebuilds them.
+  auto const copy = assns;
+  BOOST_TEST(&copy.leftKeyIndex(aID) != &index);
+  assns.addSingle(Ptr<int>{aID, &as[3], 3}, Ptr<float>{bID, &bs[5], 5}, 50);
+  BOOST_TEST(assns.leftKeyIndex(aID).degree(3) == 1ull);
+  BOOST_TEST(copy.leftKeyIndex(aID).degree(3) == 0ull);
+}
+
+BOOST_AUTO_TEST_CASE(missing_assns)
+{
+  MockEvent const event{nullptr};
+  helper_t const finder{event, InputTag{"assns"}};
+  std::vector<std::vector<float const*>> bColl;
+  std::vector<std::vector<short const*>> dColl;
+  BOOST_TEST(!!finder(std::vector<int>{}, aID, bColl, dColl));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
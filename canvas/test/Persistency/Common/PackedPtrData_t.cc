@@ -0,0 +1,131 @@
+#define BOOST_TEST_MODULE (PackedPtrData_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/AssnsBase.h"
+#include "canvas/Persistency/Common/EDProductGetter.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/RefCore.h"
+#include "canvas/Persistency/Common/detail/PackedPtrData.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace art;
+using detail::PackedPtrData;
+
+namespace {
+  ProductID const aID{1};
+  ProductID const bID{2};
+  ProductID const cID{3};
+
+  EDProductGetter const getter;
+
+  using assns_t = Assns<int, float>;
+
+  // The associations after a write (fill_from_transients) and a read
+  // (fill_transients).
+  std::vector<assns_t::assn_t>
+  round_trip(assns_t assns)
+  {
+    detail::AssnsBase& base = assns;
+    base.fill_from_transients();
+    base.fill_from_transients(); // Second output module.
+    base.fill_transients();
+    return {assns.begin(), assns.end()};
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(PackedPtrData_t)
+
+BOOST_AUTO_TEST_CASE(one_product)
+{
+  PackedPtrData data;
+  BOOST_TEST(data.empty());
+  RefCore const a{aID, nullptr, &getter};
+  BOOST_TEST(data.push_back(a, 3));
+  BOOST_TEST(data.push_back(a, 0));
+  BOOST_TEST(data.push_back(a, -1));
+  BOOST_TEST(data.size() == 3ull);
+  BOOST_TEST(data.key(0) == 3ull);
+  BOOST_TEST(data.key(1) == 0ull);
+  BOOST_TEST(data.key(2) == std::size_t(-1));
+  BOOST_TEST(data.product(2).id() == aID);
+  BOOST_TEST(data.product(2).productGetter() == &getter);
+  data.clear();
+  BOOST_TEST(data.empty());
+}
+
+BOOST_AUTO_TEST_CASE(several_products)
+{
+  PackedPtrData data;
+  RefCore const a{aID, nullptr, nullptr};
+  RefCore const b{bID, nullptr, nullptr};
+  RefCore const null{};
+  std::vector<std::pair<RefCore, std::size_t>> const ptrs{
+    {a, 0}, {a, 1}, {b, 7}, {a, 2}, {null, -1}, {b, 8}};
+  for (auto const& [product, key] : ptrs) {
+    BOOST_TEST(data.push_back(product, key));
+  }
+  BOOST_TEST_REQUIRE(data.size() == ptrs.size());
+  for (std::size_t i{}; i != ptrs.size(); ++i) {
+    BOOST_TEST(data.product(i).id() == ptrs[i].first.id());
+    BOOST_TEST(data.key(i) == ptrs[i].second);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(unpackable)
+{
+  PackedPtrData data;
+  RefCore const a{aID, nullptr, nullptr};
+  BOOST_TEST(data.push_back(a, 1));
+  BOOST_TEST(!data.push_back(a, std::size_t{1} << 32));
+  BOOST_TEST(!data.push_back(a, std::uint32_t(-1)));
+  BOOST_TEST(data.size() == 1ull);
+
+  // Up to 65536 products.
+  auto const product = [](unsigned const i) {
+    return RefCore{ProductID{i}, nullptr, nullptr};
+  };
+  for (unsigned i{2}; i <= 65536u; ++i) {
+    BOOST_TEST_REQUIRE(data.push_back(product(i), 0));
+  }
+  BOOST_TEST(!data.push_back(product(65537), 0));
+  BOOST_TEST(data.push_back(a, 2));
+  BOOST_TEST(data.size() == 65537ull);
+  BOOST_TEST(data.product(65536).id() == aID);
+}
+
+BOOST_AUTO_TEST_CASE(assns_round_trip)
+{
+  assns_t assns;
+  for (std::size_t i{}; i != 10; ++i) {
+    assns.addSingle(Ptr<int>{aID, i / 2, &getter},
+                    Ptr<float>{i % 3 ? bID : cID, i, &getter});
+  }
+  assns.addSingle(Ptr<int>{}, Ptr<float>{bID, 11, &getter});
+  std::vector<assns_t::assn_t> const expected{assns.begin(), assns.end()};
+  auto const result = round_trip(assns);
+  BOOST_TEST_REQUIRE(result.size() == expected.size());
+  for (std::size_t i{}; i != result.size(); ++i) {
+    BOOST_TEST((result[i] == expected[i]));
+    BOOST_TEST(result[i].second.productGetter() == &getter);
+  }
+  BOOST_TEST(result.back().first.isNull());
+  BOOST_TEST(round_trip(assns_t{}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(assns_round_trip_unpacked)
+{
+  assns_t assns;
+  assns.addSingle(Ptr<int>{aID, 1, &getter}, Ptr<float>{bID, 2, &getter});
+  assns.addSingle(Ptr<int>{aID, std::size_t{1} << 40, &getter},
+                  Ptr<float>{bID, 3, &getter});
+  std::vector<assns_t::assn_t> const expected{assns.begin(), assns.end()};
+  auto const result = round_trip(assns);
+  BOOST_TEST((result == expected));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,73 @@
+#define BOOST_TEST_MODULE (map_vector_ptr_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/getElementAddresses.h"
+#include "canvas/Persistency/Common/setPtr.h"
+#include "cetlib/map_vector.h"
+
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace {
+  struct Base {
+    int b{};
+  };
+  struct Particle : Base {
+    int id{};
+  };
+
+  using particles_t = cet::map_vector<Particle>;
+  using value_t = particles_t::value_type;
+
+  particles_t
+  make_particles()
+  {
+    particles_t result;
+    for (unsigned i = 1; i < 10; i += 2) {
+      result[cet::map_vector_key{i}].id = static_cast<int>(i);
+    }
+    return result;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(map_vector_ptr_t)
+
+BOOST_AUTO_TEST_CASE(setPtr_t)
+{
+  auto const particles = make_particles();
+  auto const& expected = *particles.find(cet::map_vector_key{3});
+  // Repeated calls must give the same answer as the first.
+  for (int i = 0; i < 3; ++i) {
+    void const* p{nullptr};
+    art::setPtr(particles, typeid(Particle), 3, p);
+    BOOST_TEST(p == &expected.second);
+    art::setPtr(particles, typeid(Base), 3, p);
+    BOOST_TEST(p == static_cast<Base const*>(&expected.second));
+    art::setPtr(particles, typeid(value_t), 3, p);
+    BOOST_TEST(p == &expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(getElementAddresses_t)
+{
+  auto const particles = make_particles();
+  std::vector<unsigned long> const indices{1, 2, 9};
+  for (int i = 0; i < 3; ++i) {
+    std::vector<void const*> mapped;
+    art::getElementAddresses(particles, typeid(Particle), indices, mapped);
+    BOOST_TEST_REQUIRE(mapped.size() == indices.size());
+    BOOST_TEST(mapped[0] == particles.getOrNull(cet::map_vector_key{1}));
+    BOOST_TEST(mapped[1] == nullptr);
+    BOOST_TEST(mapped[2] == particles.getOrNull(cet::map_vector_key{9}));
+
+    std::vector<void const*> values;
+    art::getElementAddresses(particles, typeid(value_t), indices, values);
+    BOOST_TEST_REQUIRE(values.size() == indices.size());
+    BOOST_TEST(values[0] == &*particles.find(cet::map_vector_key{1}));
+    BOOST_TEST(values[1] == nullptr);
+    BOOST_TEST(values[2] == &*particles.find(cet::map_vector_key{9}));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
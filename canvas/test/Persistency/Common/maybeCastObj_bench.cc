@@ -0,0 +1,79 @@
+// vim: set sw=2 expandtab :
+
+// Times the conversion of the addresses of the elements of a
+// 1M-element vector of derived objects to those of a base class at a
+// non-zero offset, element by element with detail::maybeCastObj and
+// for the whole collection with getElementAddresses, N times, N given
+// on the command line (default: 10).
+
+#include "canvas/Persistency/Common/detail/maybeCastObj.h"
+#include "canvas/Persistency/Common/getElementAddresses.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+using namespace art;
+
+namespace {
+
+  constexpr std::size_t n_elements{1'000'000};
+
+  struct Base1 {
+    double x{};
+  };
+  struct Base2 {
+    double y{};
+  };
+  struct Derived : Base1, Base2 {
+    double z{};
+  };
+
+  template <typename F>
+  double
+  ns_per_element(unsigned const repeats, F f)
+  {
+    auto const start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i != repeats; ++i) {
+      f();
+    }
+    std::chrono::duration<double, std::nano> const elapsed{
+      std::chrono::steady_clock::now() - start};
+    return elapsed.count() / (double(repeats) * n_elements);
+  }
+
+} // unnamed namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const repeats = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10;
+  std::vector<Derived> const coll(n_elements);
+  std::vector<unsigned long> indices(n_elements);
+  std::iota(indices.begin(), indices.end(), 0ul);
+  std::vector<void const*> addresses;
+  addresses.reserve(n_elements);
+
+  auto const one_by_one = ns_per_element(repeats, [&] {
+    addresses.clear();
+    for (auto const& element : coll) {
+      addresses.push_back(detail::maybeCastObj(&element, typeid(Base2)));
+    }
+  });
+  auto const whole = ns_per_element(repeats, [&] {
+    addresses.clear();
+    getElementAddresses(coll, typeid(Base2), indices, addresses);
+  });
+  if (addresses.back() != static_cast<Base2 const*>(&coll.back())) {
+    std::cerr << "Wrong address.\n";
+    return 1;
+  }
+  std::cout << std::fixed << std::setprecision(2)
+            << "maybeCastObj         " << std::setw(8) << one_by_one
+            << " ns/element\n"
+            << "getElementAddresses  " << std::setw(8) << whole
+            << " ns/element\n";
+}
@@ -2,8 +2,11 @@
 #include "boost/test/unit_test.hpp"
 
 #include <string>
+#include <vector>
 
 #include "canvas/Persistency/Common/detail/maybeCastObj.h"
+#include "canvas/Persistency/Common/getElementAddresses.h"
+#include "canvas/Utilities/Exception.h"
 namespace {
   // Helper function
   template <typename T, typename U>
@@ -67,6 +70,17 @@ namespace {
   class MCConcreteMultiple : public MCBase, public MCOtherBase {};
 
   // Ambiguous?
+
+  // Bases at non-zero offsets
+  struct MCFirst {
+    int first{1};
+  };
+  struct MCSecond {
+    int second{2};
+  };
+  struct MCBoth : MCFirst, MCSecond {
+    int both{3};
+  };
 }
 
 BOOST_AUTO_TEST_SUITE(maybeCastObj_t)
@@ -141,4 +155,34 @@ BOOST_AUTO_TEST_CASE(user_type_variables)
     typeid(refToBaseVirtual), typeid(MCConcreteVirtual_B))));
 }
 
+BOOST_AUTO_TEST_CASE(upcast_offsets)
+{
+  MCBoth const both{};
+  MCSecond const* second = &both;
+  // The offset is cached after the first call.
+  for (int i = 0; i < 3; ++i) {
+    BOOST_TEST(art::detail::maybeCastObj(&both, typeid(MCSecond)) == second);
+    BOOST_TEST(art::detail::upcastOffset(typeid(MCBoth), typeid(MCSecond)) ==
+               reinterpret_cast<char const*>(second) -
+                 reinterpret_cast<char const*>(&both));
+  }
+  MCBoth const* none{nullptr};
+  BOOST_TEST(art::detail::maybeCastObj(none, typeid(MCSecond)) == nullptr);
+  BOOST_CHECK_THROW(art::detail::maybeCastObj(&both, typeid(MCConcrete)),
+                    art::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(element_addresses)
+{
+  std::vector<MCBoth> const coll(4);
+  std::vector<unsigned long> const indices{3, 0, 2};
+  std::vector<void const*> addresses;
+  art::getElementAddresses(coll, typeid(MCSecond), indices, addresses);
+  BOOST_TEST_REQUIRE(addresses.size() == indices.size());
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    BOOST_TEST(addresses[i] ==
+               static_cast<MCSecond const*>(&coll[indices[i]]));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
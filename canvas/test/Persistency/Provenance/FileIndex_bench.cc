@@ -0,0 +1,111 @@
+// vim: set sw=2 expandtab :
+
+// Times the construction of a FileIndex from N entries, N given on the
+// command line (default: 1M, 10M and 100M), comparing:
+//
+//   - one addEntryOnLoad call per element followed by a sort,
+//   - a bulk load of entries that are already sorted, and
+//   - a bulk load of shuffled entries (parallel sort).
+
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Persistency/Provenance/FileIndex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace art;
+
+namespace {
+
+  constexpr unsigned events_per_subrun{100};
+  constexpr unsigned subruns_per_run{100};
+
+  // Entries in the order written by RootOutput.
+  std::vector<FileIndex::Element>
+  make_entries(std::size_t const n)
+  {
+    std::vector<FileIndex::Element> result;
+    result.reserve(n);
+    FileIndex::EntryNumber_t entry{};
+    for (RunNumber_t r = 1; result.size() < n; ++r) {
+      result.emplace_back(EventID::invalidEvent(RunID{r}), r - 1);
+      for (SubRunNumber_t sr = 0; sr != subruns_per_run && result.size() < n;
+           ++sr) {
+        result.emplace_back(EventID::invalidEvent(SubRunID{r, sr}), sr);
+        for (EventNumber_t e = 1;
+             e <= events_per_subrun && result.size() < n;
+             ++e) {
+          result.emplace_back(EventID{r, sr, e}, entry++);
+        }
+      }
+    }
+    return result;
+  }
+
+  template <typename F>
+  double
+  time_ms(F f)
+  {
+    auto const start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> const elapsed{
+      std::chrono::steady_clock::now() - start};
+    return elapsed.count();
+  }
+
+  void
+  report(std::size_t const n, char const* what, double const ms)
+  {
+    std::cout << std::setw(12) << n << "  " << std::left << std::setw(28)
+              << what << std::right << std::setw(12) << std::fixed
+              << std::setprecision(1) << ms << " ms\n";
+  }
+
+} // unnamed namespace
+
+int
+main(int argc, char** argv)
+{
+  std::vector<std::size_t> sizes;
+  for (int i = 1; i < argc; ++i) {
+    sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+  }
+  if (sizes.empty()) {
+    sizes = {1'000'000, 10'000'000, 100'000'000};
+  }
+
+  for (auto const n : sizes) {
+    auto const sorted = make_entries(n);
+    auto shuffled = sorted;
+    std::shuffle(begin(shuffled), end(shuffled), std::mt19937{n});
+
+    {
+      FileIndex index;
+      report(n, "addEntryOnLoad + sort", time_ms([&index, &shuffled] {
+               for (auto const& e : shuffled) {
+                 index.addEntryOnLoad(e.eventID, e.entry);
+               }
+               index.sortBy_Run_SubRun_Event();
+             }));
+    }
+    {
+      FileIndex index;
+      auto buffer = sorted;
+      report(n, "addEntriesOnLoad (sorted)", time_ms([&index, &buffer] {
+               index.addEntriesOnLoad(std::move(buffer));
+             }));
+    }
+    {
+      FileIndex index;
+      report(n, "addEntriesOnLoad (shuffled)", time_ms([&index, &shuffled] {
+               index.addEntriesOnLoad(shuffled.data(),
+                                      shuffled.data() + shuffled.size());
+             }));
+    }
+  }
+}
@@ -2,6 +2,11 @@
 #include "boost/test/unit_test.hpp"
 #include "canvas/Persistency/Provenance/FileIndex.h"
 
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
 namespace art {
   std::ostream&
   boost_test_print_type(std::ostream& os, FileIndex::iterator it)
@@ -19,6 +24,29 @@ using art::EventID;
 using art::RunID;
 using art::SubRunID;
 
+namespace {
+
+  // Reference implementation: search the sorted entries directly.
+  template <typename Match>
+  art::FileIndex::const_iterator
+  referenceFind(art::FileIndex const& index, EventID const& id, Match match)
+  {
+    auto it = std::lower_bound(
+      index.cbegin(), index.cend(), art::FileIndex::Element{id});
+    while (it != index.cend() && !match(*it)) {
+      ++it;
+    }
+    return it;
+  }
+
+  bool
+  isType(art::FileIndex::Element const& e, art::FileIndex::EntryType t)
+  {
+    return e.getEntryType() == t;
+  }
+
+} // unnamed namespace
+
 BOOST_AUTO_TEST_SUITE(FileIndex_t)
 
 BOOST_AUTO_TEST_CASE(constructAndInsertTest)
@@ -444,4 +472,291 @@ BOOST_AUTO_TEST_CASE(eventsUniqueAndOrderedTest)
   BOOST_TEST(fileIndex8.eventsUniqueAndOrdered());
 }
 
+BOOST_AUTO_TEST_CASE(bulkLoadTest)
+{
+  using Element = art::FileIndex::Element;
+  std::vector<Element> const unsorted{{EventID(3, 3, 2), 5},
+                                      {EventID::invalidEvent(RunID(3)), 7},
+                                      {EventID(1, 2, 2), 2},
+                                      {EventID(3, 3, 2), 4},
+                                      {EventID::invalidEvent(SubRunID(3, 3)), 6},
+                                      {EventID::invalidEvent(RunID(1)), 8}};
+
+  art::FileIndex reference;
+  for (auto const& e : unsorted) {
+    reference.addEntry(e.eventID, e.entry);
+  }
+  reference.sortBy_Run_SubRun_Event();
+
+  art::FileIndex fromBuffer;
+  fromBuffer.addEntriesOnLoad(std::vector<Element>(unsorted));
+  BOOST_TEST(fromBuffer == reference);
+  BOOST_TEST(std::equal(fromBuffer.cbegin(),
+                        fromBuffer.cend(),
+                        reference.cbegin(),
+                        [](Element const& a, Element const& b) {
+                          return a.eventID == b.eventID && a.entry == b.entry;
+                        }));
+  BOOST_TEST((fromBuffer.findPosition(EventID(3, 3, 2), true) -
+              fromBuffer.cbegin()) == 4);
+
+  // Appending, in two pieces, data that are already sorted.
+  std::vector<Element> const sorted(reference.cbegin(), reference.cend());
+  art::FileIndex fromSpan;
+  fromSpan.addEntriesOnLoad(sorted.data(), sorted.data() + 3);
+  fromSpan.addEntriesOnLoad(sorted.data() + 3, sorted.data() + sorted.size());
+  BOOST_TEST(fromSpan == reference);
+  BOOST_TEST(fromSpan.contains(EventID(1, 2, 2), true));
+}
+
+BOOST_AUTO_TEST_CASE(parallelSortTest)
+{
+  // Large enough to exercise the parallel sort; the many duplicates
+  // check that it is stable.
+  std::mt19937 gen{5678};
+  std::uniform_int_distribution<unsigned> number{1, 20};
+  std::vector<art::FileIndex::Element> elements;
+  for (art::FileIndex::EntryNumber_t i = 0; i != 500000; ++i) {
+    elements.emplace_back(EventID(number(gen), number(gen), number(gen)), i);
+  }
+  auto expected = elements;
+  std::stable_sort(begin(expected), end(expected));
+
+  art::FileIndex fileIndex;
+  fileIndex.addEntriesOnLoad(std::move(elements));
+  BOOST_TEST(std::equal(fileIndex.cbegin(),
+                        fileIndex.cend(),
+                        cbegin(expected),
+                        cend(expected),
+                        [](auto const& a, auto const& b) {
+                          return a.eventID == b.eventID && a.entry == b.entry;
+                        }));
+}
+
+BOOST_AUTO_TEST_CASE(directoryMatchesSortedSearchTest)
+{
+  std::mt19937 gen{1234};
+  std::uniform_int_distribution<unsigned> flip{0, 3};
+  art::FileIndex fileIndex;
+  art::FileIndex::EntryNumber_t entry{};
+  for (unsigned r = 1; r < 12; r += 1 + flip(gen)) {
+    fileIndex.addEntry(EventID::invalidEvent(RunID(r)), entry++);
+    for (unsigned sr = 0; sr < 20; sr += 1 + flip(gen)) {
+      if (flip(gen) != 0) {
+        fileIndex.addEntry(EventID::invalidEvent(SubRunID(r, sr)), entry++);
+      }
+      for (unsigned e = 1; e < 40; e += 1 + flip(gen)) {
+        fileIndex.addEntry(EventID(r, sr, e), entry++);
+      }
+    }
+  }
+  fileIndex.sortBy_Run_SubRun_Event();
+
+  auto const events = [](auto const& e) {
+    return isType(e, art::FileIndex::kEvent);
+  };
+  auto const subRuns = [](auto const& e) {
+    return isType(e, art::FileIndex::kSubRun);
+  };
+  auto const runs = [](auto const& e) {
+    return isType(e, art::FileIndex::kRun);
+  };
+  auto const subRunsOrRuns = [](auto const& e) {
+    return !isType(e, art::FileIndex::kEvent);
+  };
+  auto const end = fileIndex.cend();
+
+  for (unsigned r = 1; r != 15; ++r) {
+    RunID const rID{r};
+    auto ref = referenceFind(fileIndex, EventID::invalidEvent(rID), runs);
+    BOOST_TEST((fileIndex.findPosition(rID, false) == ref));
+    bool const haveRun = ref != end && ref->eventID.runID() == rID;
+    BOOST_TEST((fileIndex.findPosition(rID, true) == (haveRun ? ref : end)));
+    for (unsigned sr = 0; sr != 22; ++sr) {
+      SubRunID const srID{r, sr};
+      auto const invID = EventID::invalidEvent(srID);
+      ref = referenceFind(fileIndex, invID, subRuns);
+      BOOST_TEST((fileIndex.findPosition(srID, false) == ref));
+      bool const haveSubRun = ref != end && ref->eventID.subRunID() == srID;
+      BOOST_TEST(
+        (fileIndex.findPosition(srID, true) == (haveSubRun ? ref : end)));
+      BOOST_TEST((fileIndex.findSubRunOrRunPosition(srID) ==
+                  referenceFind(fileIndex, invID, subRunsOrRuns)));
+      for (unsigned e = 1; e != 42; ++e) {
+        EventID const id{srID, e};
+        ref = referenceFind(fileIndex, id, [](auto const&) { return true; });
+        BOOST_TEST((fileIndex.findPosition(id) == ref));
+        ref = referenceFind(fileIndex, id, events);
+        BOOST_TEST((fileIndex.findPosition(id, false) == ref));
+        bool const haveEvent = ref != end && ref->eventID == id;
+        BOOST_TEST(
+          (fileIndex.findPosition(id, true) == (haveEvent ? ref : end)));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(unspecifiedSubRunManySubRunsTest)
+{
+  // Event numbers increase across the subruns of each run, as is
+  // usual: each event is identified by its run and event numbers.
+  art::FileIndex fileIndex;
+  art::FileIndex::EntryNumber_t entry{};
+  for (unsigned r = 1; r != 4; ++r) {
+    fileIndex.addEntry(EventID::invalidEvent(RunID(r)), entry++);
+    unsigned event{10};
+    for (unsigned sr = 0; sr != 1000; ++sr) {
+      fileIndex.addEntry(EventID::invalidEvent(SubRunID(r, sr)), entry++);
+      for (unsigned e = 0; e != 3; ++e, event += 2) {
+        fileIndex.addEntry(EventID(r, sr, event), entry++);
+      }
+    }
+  }
+  fileIndex.sortBy_Run_SubRun_Event();
+
+  auto const unspecified = [](unsigned const r, unsigned const e) {
+    return EventID(SubRunID::invalidSubRun(RunID(r)), e);
+  };
+
+  // Run 2, subrun 500, third event.
+  auto it = fileIndex.findPosition(unspecified(2, 3014), true);
+  BOOST_TEST_REQUIRE((it != fileIndex.end()));
+  BOOST_TEST(it->eventID == EventID(2, 500, 3014));
+  BOOST_TEST((fileIndex.findPosition(unspecified(2, 3014), false) == it));
+
+  // Between events: the next event, or nothing if exact.
+  BOOST_TEST((fileIndex.findPosition(unspecified(2, 3015), true) ==
+              fileIndex.end()));
+  it = fileIndex.findPosition(unspecified(2, 3015), false);
+  BOOST_TEST(it->eventID == EventID(2, 501, 3016));
+
+  // Past the last event of the run: the first event of the next run.
+  it = fileIndex.findPosition(unspecified(2, 7000), false);
+  BOOST_TEST(it->eventID == EventID(3, 0, 10));
+
+  // Before the first event of the run, or in a run not in the index.
+  BOOST_TEST((fileIndex.findPosition(unspecified(2, 9), false) ==
+              fileIndex.end()));
+  BOOST_TEST((fileIndex.findPosition(unspecified(5, 10), false) ==
+              fileIndex.end()));
+
+  // Adding an entry discards the index.
+  fileIndex.addEntry(EventID(2, 1000, 7000), entry++);
+  fileIndex.sortBy_Run_SubRun_Event();
+  it = fileIndex.findPosition(unspecified(2, 7000), true);
+  BOOST_TEST_REQUIRE((it != fileIndex.end()));
+  BOOST_TEST(it->eventID == EventID(2, 1000, 7000));
+}
+
+BOOST_AUTO_TEST_CASE(batchLookupTest)
+{
+  art::FileIndex fileIndex;
+  art::FileIndex::EntryNumber_t entry{};
+  for (unsigned r = 1; r != 5; ++r) {
+    fileIndex.addEntry(EventID::invalidEvent(RunID(r)), entry++);
+    for (unsigned sr = 0; sr != 6; sr += 2) {
+      fileIndex.addEntry(EventID::invalidEvent(SubRunID(r, sr)), entry++);
+      for (unsigned e = 10 * sr + 1; e < 10 * sr + 10; e += 2) {
+        fileIndex.addEntry(EventID(r, sr, e), entry++);
+      }
+    }
+  }
+  fileIndex.sortBy_Run_SubRun_Event();
+
+  // Queries in no particular order, with duplicates and IDs that have
+  // no subrun specified.
+  std::vector<EventID> queries;
+  for (unsigned r = 1; r != 6; ++r) {
+    for (unsigned sr = 0; sr != 7; ++sr) {
+      for (unsigned e = 1; e != 62; ++e) {
+        queries.emplace_back(r, sr, e);
+      }
+    }
+    for (unsigned e = 1; e < 62; e += 3) {
+      queries.emplace_back(SubRunID::invalidSubRun(RunID(r)), e);
+    }
+  }
+  queries.push_back(queries.front());
+  std::shuffle(begin(queries), end(queries), std::mt19937{91011});
+
+  for (bool const exact : {true, false}) {
+    auto const positions = fileIndex.findPositions(
+      art::span<EventID const>{queries.data(), queries.size()}, exact);
+    BOOST_TEST_REQUIRE(positions.size() == queries.size());
+    for (std::size_t i = 0; i != queries.size(); ++i) {
+      BOOST_TEST((positions[i] == fileIndex.findPosition(queries[i], exact)));
+    }
+  }
+  BOOST_TEST(fileIndex.findPositions({}, true).empty());
+}
+
+BOOST_AUTO_TEST_CASE(concurrentFirstLookupTest)
+{
+  art::FileIndex fileIndex;
+  art::FileIndex::EntryNumber_t entry{};
+  for (unsigned r = 1; r != 3; ++r) {
+    fileIndex.addEntry(EventID::invalidEvent(RunID(r)), entry++);
+    for (unsigned sr = 0; sr != 100; ++sr) {
+      fileIndex.addEntry(EventID::invalidEvent(SubRunID(r, sr)), entry++);
+      for (unsigned e = 0; e != 10; ++e) {
+        fileIndex.addEntry(EventID(r, sr, 10 * sr + e), entry++);
+      }
+    }
+  }
+  fileIndex.sortBy_Run_SubRun_Event();
+
+  // The lookup structures are built by whichever threads get there
+  // first; every thread must see complete ones.
+  art::FileIndex const& index = fileIndex;
+  std::vector<std::size_t> found(8);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t != found.size(); ++t) {
+    threads.emplace_back([&index, &found, t] {
+      for (unsigned i = 0; i != 1000; ++i) {
+        unsigned const r = 1 + i % 2;
+        unsigned const sr = i % 100;
+        EventID const id{r, sr, 10 * sr + i % 10};
+        EventID const unspecified{SubRunID::invalidSubRun(RunID(r)),
+                                  id.event()};
+        auto const it = index.findPosition(id, true);
+        found[t] += it != index.cend() && it->eventID == id &&
+                    index.findPosition(unspecified, true) == it;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto const n : found) {
+    BOOST_TEST(n == 1000u);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(modifyThroughIteratorsTest)
+{
+  art::FileIndex fileIndex;
+  fileIndex.addEntry(EventID(1, 0, 1), 0);
+  fileIndex.addEntry(EventID(1, 0, 2), 1);
+  fileIndex.sortBy_Run_SubRun_Event();
+  BOOST_TEST((fileIndex.findPosition(EventID(1, 0, 2), true) !=
+              fileIndex.cend()));
+
+  // Seen by lookups at once when the order is kept.
+  (fileIndex.end() - 1)->eventID = EventID(1, 0, 5);
+  BOOST_TEST((fileIndex.findPosition(EventID(1, 0, 2), true) ==
+              fileIndex.cend()));
+  auto const last = fileIndex.findPosition(EventID(1, 0, 5), true);
+  BOOST_TEST_REQUIRE((last != fileIndex.cend()));
+  BOOST_TEST(last->entry == 1);
+
+  // Seen by lookups once the index is re-sorted otherwise.
+  fileIndex.begin()->eventID = EventID(1, 0, 7);
+  fileIndex.sortBy_Run_SubRun_Event();
+  BOOST_TEST((fileIndex.findPosition(EventID(1, 0, 1), true) ==
+              fileIndex.cend()));
+  auto const it = fileIndex.findPosition(EventID(1, 0, 7), true);
+  BOOST_TEST_REQUIRE((it != fileIndex.cend()));
+  BOOST_TEST(it->entry == 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,129 @@
+#define BOOST_TEST_MODULE (Hash_t)
+#include "boost/test/unit_test.hpp"
+#include "canvas/Persistency/Provenance/Hash.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using TestHash = art::Hash<0>;
+
+namespace {
+  std::string const hex1{"0123456789abcdef0123456789abcdef"};
+  std::string const hex2{"ff23456789abcdef0123456789abcdee"};
+  std::string const hex3{"0023456789abcdef0123456789abcdef"};
+}
+
+BOOST_AUTO_TEST_SUITE(Hash_t)
+
+BOOST_AUTO_TEST_CASE(construction)
+{
+  TestHash const invalid;
+  BOOST_TEST(!invalid.isValid());
+  BOOST_TEST(invalid.compactForm() == art::detail::InvalidHash());
+  BOOST_TEST(TestHash{""} == invalid);
+
+  TestHash const h1{hex1};
+  BOOST_TEST(h1.isValid());
+  BOOST_TEST(h1.isCompactForm());
+  BOOST_TEST(h1.compactForm().size() == 16u);
+  BOOST_TEST(TestHash{h1.compactForm()} == h1);
+
+  std::ostringstream os;
+  os << h1;
+  BOOST_TEST(os.str() == hex1);
+
+  BOOST_CHECK_THROW(TestHash{"not a hash"}, art::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(ordering)
+{
+  // Hashes must order as their compact string forms did.
+  std::vector<std::string> const hexes{hex1, hex2, hex3};
+  for (auto const& a : hexes) {
+    for (auto const& b : hexes) {
+      TestHash const ha{a};
+      TestHash const hb{b};
+      BOOST_TEST((ha < hb) == (ha.compactForm() < hb.compactForm()));
+      BOOST_TEST((ha > hb) == (ha.compactForm() > hb.compactForm()));
+      BOOST_TEST((ha == hb) == (a == b));
+      BOOST_TEST((ha != hb) == (a != b));
+    }
+  }
+
+  std::map<TestHash, int> const m{{TestHash{hex2}, 2}, {TestHash{hex1}, 1}};
+  BOOST_TEST(m.at(TestHash{hex1}) == 1);
+  BOOST_TEST(m.begin()->second == 1);
+}
+
+BOOST_AUTO_TEST_CASE(hashing)
+{
+  std::unordered_set<TestHash> const s{TestHash{hex1}, TestHash{hex2}};
+  BOOST_TEST(s.count(TestHash{hex1}) == 1u);
+  BOOST_TEST(s.count(TestHash{hex3}) == 0u);
+  BOOST_TEST(std::hash<TestHash>{}(TestHash{hex1}) ==
+             std::hash<TestHash>{}(TestHash{hex1}));
+}
+
+BOOST_AUTO_TEST_CASE(persistentForm)
+{
+  TestHash const h1{hex1};
+  BOOST_TEST(art::detail::hash_bytes(hex1) ==
+             art::detail::hash_bytes(h1.compactForm()));
+  BOOST_TEST(art::detail::hash_bytes("") == art::detail::InvalidHashBytes());
+
+  // Hashes made from either form are the same.
+  for (auto const& form : {hex1, h1.compactForm()}) {
+    TestHash const h{form};
+    BOOST_TEST(h.isValid());
+    BOOST_TEST(h == h1);
+    BOOST_TEST(!(h < h1));
+    BOOST_TEST(h.hash() == h1.hash());
+    BOOST_TEST(h.compactForm() == h1.compactForm());
+
+    std::ostringstream os;
+    os << h;
+    BOOST_TEST(os.str() == hex1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(copyingAndMoving)
+{
+  TestHash const h1{hex1};
+  TestHash const h2{hex2};
+
+  TestHash copy{h1};
+  BOOST_TEST(copy == h1);
+  TestHash assigned{h2};
+  assigned = h1;
+  BOOST_TEST(assigned == h1);
+  BOOST_TEST(assigned.hash() == h1.hash());
+
+  // An object given a new value compares as that value only.
+  assigned = h2;
+  BOOST_TEST(assigned == h2);
+  BOOST_TEST(assigned != h1);
+  BOOST_TEST(assigned.hash() == h2.hash());
+
+  TestHash moved{std::move(copy)};
+  BOOST_TEST(moved == h1);
+  BOOST_TEST(!copy.isValid());
+  BOOST_TEST(copy == TestHash{});
+  copy = std::move(moved);
+  BOOST_TEST(copy == h1);
+}
+
+BOOST_AUTO_TEST_CASE(swapping)
+{
+  TestHash a{hex1};
+  TestHash b{hex2};
+  swap(a, b);
+  BOOST_TEST(a == TestHash{hex2});
+  BOOST_TEST(b == TestHash{hex1});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,144 @@
+#define BOOST_TEST_MODULE (MappedFileIndex_t)
+#include "boost/test/unit_test.hpp"
+#include "canvas/Persistency/Provenance/MappedFileIndex.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+using art::EventID;
+using art::FileIndex;
+using art::MappedFileIndex;
+using art::RunID;
+using art::SubRunID;
+
+namespace {
+
+  FileIndex
+  makeIndex()
+  {
+    FileIndex index;
+    FileIndex::EntryNumber_t entry{};
+    for (unsigned r = 1; r < 6; r += 2) {
+      index.addEntry(EventID::invalidEvent(RunID(r)), entry++);
+      for (unsigned sr = 0; sr < 8; sr += 3) {
+        index.addEntry(EventID::invalidEvent(SubRunID(r, sr)), entry++);
+        for (unsigned e = 10 * sr + 1; e < 10 * sr + 10; e += 2) {
+          index.addEntry(EventID(r, sr, e), entry++);
+        }
+      }
+    }
+    // A subrun with events but no subrun entry.
+    index.addEntry(EventID(5, 9, 3), entry++);
+    index.sortBy_Run_SubRun_Event();
+    return index;
+  }
+
+  template <typename T>
+  std::ptrdiff_t
+  position(FileIndex const& index, T const& id, bool const exact)
+  {
+    return index.findPosition(id, exact) - index.cbegin();
+  }
+
+  template <typename T>
+  std::ptrdiff_t
+  position(MappedFileIndex const& index, T const& id, bool const exact)
+  {
+    return index.findPosition(id, exact) - index.cbegin();
+  }
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(MappedFileIndex_t)
+
+BOOST_AUTO_TEST_CASE(writeAndMapTest)
+{
+  auto const index = makeIndex();
+  std::string const filename{"MappedFileIndex_t.fidx"};
+  MappedFileIndex::write(index, filename);
+  MappedFileIndex const mapped{filename};
+
+  BOOST_TEST_REQUIRE(mapped.size() == index.size());
+  BOOST_TEST(!mapped.empty());
+  auto it = index.cbegin();
+  for (auto const& e : mapped) {
+    BOOST_TEST(e.eventID == it->eventID);
+    BOOST_TEST(e.entry == it->entry);
+    ++it;
+  }
+
+  for (bool const exact : {true, false}) {
+    for (unsigned r = 1; r != 8; ++r) {
+      RunID const rID{r};
+      BOOST_TEST(position(mapped, rID, exact) == position(index, rID, exact));
+      BOOST_TEST(mapped.contains(rID, exact) == index.contains(rID, exact));
+      for (unsigned sr = 0; sr != 11; ++sr) {
+        SubRunID const srID{r, sr};
+        BOOST_TEST(position(mapped, srID, exact) ==
+                   position(index, srID, exact));
+        BOOST_TEST((mapped.findSubRunOrRunPosition(srID) - mapped.cbegin()) ==
+                   (index.findSubRunOrRunPosition(srID) - index.cbegin()));
+        for (unsigned e = 1; e != 100; ++e) {
+          EventID const id{srID, e};
+          BOOST_TEST(position(mapped, id, exact) ==
+                     position(index, id, exact));
+        }
+      }
+      for (unsigned e = 1; e < 100; e += 7) {
+        EventID const id{SubRunID::invalidSubRun(rID), e};
+        BOOST_TEST(position(mapped, id, exact) == position(index, id, exact));
+      }
+    }
+  }
+  BOOST_TEST(mapped.contains(EventID(3, 6, 63), true));
+  BOOST_TEST(!mapped.contains(EventID(3, 6, 64), true));
+  BOOST_TEST(mapped.contains(SubRunID(5, 3), true));
+  BOOST_TEST(!mapped.contains(SubRunID(5, 9), true));
+  BOOST_TEST(!mapped.contains(RunID(2), true));
+}
+
+BOOST_AUTO_TEST_CASE(emptyIndexTest)
+{
+  std::string const filename{"MappedFileIndex_t_empty.fidx"};
+  MappedFileIndex::write(FileIndex{}, filename);
+  MappedFileIndex mapped{filename};
+  BOOST_TEST(mapped.empty());
+  BOOST_TEST(!mapped.contains(RunID(1), false));
+
+  MappedFileIndex moved{std::move(mapped)};
+  BOOST_TEST(moved.empty());
+}
+
+BOOST_AUTO_TEST_CASE(badFileTest)
+{
+  BOOST_CHECK_THROW(MappedFileIndex{"no-such-file.fidx"}, art::Exception);
+
+  std::string const filename{"MappedFileIndex_t_bad.fidx"};
+  {
+    std::ofstream os{filename};
+    os << "This is not a FileIndex, but it is long enough to be one.";
+  }
+  BOOST_CHECK_THROW(MappedFileIndex{filename}, art::Exception);
+
+  // A header claiming 2^61 elements of 24 bytes, whose total size
+  // overflows to 0: that of the (empty) file.
+  MappedFileIndex::write(FileIndex{}, filename);
+  {
+    std::fstream fs{filename,
+                    std::ios::in | std::ios::out | std::ios::binary};
+    std::uint64_t const size{std::uint64_t{1} << 61};
+    fs.seekp(24);
+    fs.write(reinterpret_cast<char const*>(&size), sizeof(size));
+  }
+  BOOST_CHECK_THROW(MappedFileIndex{filename}, art::Exception);
+
+  FileIndex unsorted;
+  unsorted.addEntry(EventID(2, 1, 1), 0);
+  unsorted.addEntry(EventID(1, 1, 1), 1);
+  BOOST_CHECK_THROW(MappedFileIndex::write(unsorted, filename),
+                    art::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
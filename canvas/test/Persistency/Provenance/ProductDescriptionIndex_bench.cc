@@ -0,0 +1,102 @@
+// vim: set sw=2 expandtab :
+
+// Times the lookup of product descriptions by product ID in a
+// ProductDescriptionsByID map and in a ProductDescriptionIndex, for
+// 1k, 10k and 100k products, each product being looked up N times, N
+// given on the command line (default: 100).
+
+#include "canvas/Persistency/Provenance/BranchDescription.h"
+#include "canvas/Persistency/Provenance/ProcessConfigurationID.h"
+#include "canvas/Persistency/Provenance/ProductDescriptionIndex.h"
+#include "fhiclcpp/ParameterSetID.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace art;
+
+namespace {
+
+  ProductDescriptionsByID
+  make_descriptions(std::size_t const n)
+  {
+    ProductDescriptionsByID result;
+    for (std::size_t i = 0; i != n; ++i) {
+      BranchDescription pd{InEvent,
+                           "m" + std::to_string(i),
+                           "reco",
+                           "std::vector<int>",
+                           "",
+                           fhicl::ParameterSetID{},
+                           ProcessConfigurationID{},
+                           BranchDescription::Transients::Produced,
+                           false,
+                           false};
+      auto const pid = pd.productID();
+      result.try_emplace(pid, std::move(pd));
+    }
+    return result;
+  }
+
+  template <typename F>
+  double
+  ns_per_lookup(unsigned const repeats, std::vector<ProductID> const& pids, F f)
+  {
+    auto const start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i != repeats; ++i) {
+      for (auto const pid : pids) {
+        f(pid);
+      }
+    }
+    std::chrono::duration<double, std::nano> const elapsed{
+      std::chrono::steady_clock::now() - start};
+    return elapsed.count() / (double(repeats) * pids.size());
+  }
+
+} // unnamed namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const repeats =
+    argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+  std::cout << std::fixed << std::setprecision(2) << std::setw(10)
+            << "products" << std::setw(12) << "map" << std::setw(12)
+            << "index" << "  (ns/lookup)\n";
+  std::mt19937 engine{42};
+  for (std::size_t const n : {1'000u, 10'000u, 100'000u}) {
+    auto const descriptions = make_descriptions(n);
+    ProductDescriptionIndex const index{descriptions};
+    std::vector<ProductID> pids;
+    pids.reserve(descriptions.size());
+    for (auto const& [pid, pd] : descriptions) {
+      pids.push_back(pid);
+    }
+    // Look the products up in an order unrelated to that of the IDs.
+    std::shuffle(pids.begin(), pids.end(), engine);
+
+    std::size_t found{};
+    auto const by_map = ns_per_lookup(repeats, pids, [&](ProductID const pid) {
+      auto const it = descriptions.find(pid);
+      found += it != descriptions.cend() &&
+               it->second.productID() == pid;
+    });
+    auto const by_index =
+      ns_per_lookup(repeats, pids, [&](ProductID const pid) {
+        auto const pd = index.find(pid);
+        found += pd && pd->productID() == pid;
+      });
+    if (found != 2 * repeats * pids.size()) {
+      std::cerr << "Missing descriptions.\n";
+      return 1;
+    }
+    std::cout << std::setw(10) << n << std::setw(12) << by_map
+              << std::setw(12) << by_index << '\n';
+  }
+}
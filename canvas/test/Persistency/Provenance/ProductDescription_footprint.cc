@@ -0,0 +1,291 @@
+// vim: set sw=2 expandtab :
+
+// Reports the memory used by, and the time taken to copy, the
+// descriptions of a list of products held as BranchDescription objects
+// and as ProductDescription objects, and the memory used by the
+// ProductTables of the list, of which by their ProductDescriptions, and
+// by a copy of the tables.
+//
+// Usage: ProductDescription_footprint [product-list-file]
+//
+// Each line of the product list is of the form
+//
+//   <produced class name> <module label>:<instance name>:<process name>
+//
+// (lines starting with '#' are ignored), e.g. as obtained from the
+// product names of an art/ROOT file.  Without a file, a synthetic list
+// of 20k products is used.
+//
+// The heap usage is measured by counting the bytes allocated through
+// the global operator new; the nodes of the interned-string table,
+// which are allocated by TBB, are not counted.
+
+#include "canvas/Persistency/Provenance/BranchDescription.h"
+#include "canvas/Persistency/Provenance/ProcessConfigurationID.h"
+#include "canvas/Persistency/Provenance/ProductDescription.h"
+#include "canvas/Persistency/Provenance/ProductTables.h"
+#include "fhiclcpp/ParameterSetID.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace art;
+
+namespace {
+
+  std::atomic<long long> heap_bytes{};
+
+  // Each allocation is preceded by its size.
+  constexpr std::size_t header_size{alignof(std::max_align_t)};
+
+  void*
+  counted_alloc(std::size_t const n)
+  {
+    auto p = static_cast<char*>(std::malloc(n + header_size));
+    if (p == nullptr) {
+      throw std::bad_alloc{};
+    }
+    *reinterpret_cast<std::size_t*>(p) = n;
+    heap_bytes += n;
+    return p + header_size;
+  }
+
+  void
+  counted_free(void* const p) noexcept
+  {
+    if (p == nullptr) {
+      return;
+    }
+    auto const base = static_cast<char*>(p) - header_size;
+    heap_bytes -= *reinterpret_cast<std::size_t*>(base);
+    std::free(base);
+  }
+
+} // unnamed namespace
+
+void*
+operator new(std::size_t const n)
+{
+  return counted_alloc(n);
+}
+void*
+operator new[](std::size_t const n)
+{
+  return counted_alloc(n);
+}
+void
+operator delete(void* const p) noexcept
+{
+  counted_free(p);
+}
+void
+operator delete[](void* const p) noexcept
+{
+  counted_free(p);
+}
+void
+operator delete(void* const p, std::size_t) noexcept
+{
+  counted_free(p);
+}
+void
+operator delete[](void* const p, std::size_t) noexcept
+{
+  counted_free(p);
+}
+
+namespace {
+
+  struct ProductName {
+    std::string className;
+    InputTag tag;
+  };
+
+  std::vector<ProductName>
+  read_product_list(char const* const filename)
+  {
+    std::vector<ProductName> result;
+    std::ifstream in{filename};
+    if (!in) {
+      std::cerr << "Cannot open " << filename << ".\n";
+      std::exit(1);
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+      // Class names may contain spaces; the tag may not.
+      auto const space = line.find_last_of(" \t");
+      if (space == std::string::npos) {
+        std::cerr << "Malformed line: " << line << '\n';
+        std::exit(1);
+      }
+      result.push_back(
+        {line.substr(0, line.find_last_not_of(" \t", space) + 1),
+         InputTag{line.substr(space + 1)}});
+    }
+    return result;
+  }
+
+  std::vector<ProductName>
+  synthetic_product_list()
+  {
+    std::vector<std::string> const classNames{
+      "std::vector<recob::Hit>",
+      "std::vector<recob::Wire>",
+      "std::vector<recob::Track>",
+      "std::vector<recob::Cluster>",
+      "art::Assns<recob::Cluster,recob::Hit,void>",
+      "art::Assns<recob::Track,recob::Hit,recob::TrackHitMeta>"};
+    std::vector<std::string> const processes{"sim", "reco1", "reco2", "ana"};
+    std::vector<ProductName> result;
+    for (auto const& process : processes) {
+      for (int module = 0; module != 500; ++module) {
+        for (int instance = 0; instance != 10; ++instance) {
+          result.push_back({classNames[(module + instance) % 6],
+                            InputTag{"module" + std::to_string(module),
+                                     "instance" + std::to_string(instance),
+                                     process}});
+        }
+      }
+    }
+    return result;
+  }
+
+  template <typename F>
+  long long
+  heap_bytes_of(F f)
+  {
+    auto const before = heap_bytes.load();
+    f();
+    return heap_bytes.load() - before;
+  }
+
+  template <typename T>
+  double
+  ns_per_copy(std::vector<T> const& v)
+  {
+    constexpr unsigned repeats{10};
+    auto const start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i != repeats; ++i) {
+      std::vector<T> copy{v};
+      if (copy.size() != v.size()) {
+        std::abort();
+      }
+    }
+    std::chrono::duration<double, std::nano> const elapsed{
+      std::chrono::steady_clock::now() - start};
+    return elapsed.count() / (double(repeats) * v.size());
+  }
+
+  void
+  report(char const* const what,
+         std::size_t const object_size,
+         long long const bytes,
+         std::size_t const n,
+         double const copy_ns)
+  {
+    std::cout << std::left << std::setw(34) << what << std::right
+              << std::setw(8) << object_size << std::setw(12)
+              << bytes / 1024 << std::setw(12) << double(bytes) / n
+              << std::setw(12) << copy_ns << '\n';
+  }
+
+} // unnamed namespace
+
+int
+main(int argc, char** argv)
+{
+  auto const products =
+    argc > 1 ? read_product_list(argv[1]) : synthetic_product_list();
+  auto const n = products.size();
+
+  std::vector<BranchDescription> branchDescriptions;
+  auto const bd_bytes = heap_bytes_of([&] {
+    branchDescriptions.reserve(n);
+    for (auto const& [className, tag] : products) {
+      branchDescriptions.emplace_back(InEvent,
+                                      tag.label(),
+                                      tag.process(),
+                                      className,
+                                      tag.instance(),
+                                      fhicl::ParameterSetID{},
+                                      ProcessConfigurationID{},
+                                      BranchDescription::Transients::Produced,
+                                      false,
+                                      false);
+    }
+  });
+
+  // The interned strings are included.
+  std::vector<ProductDescription> productDescriptions;
+  auto const pd_bytes = heap_bytes_of([&] {
+    productDescriptions.reserve(n);
+    for (auto const& bd : branchDescriptions) {
+      productDescriptions.emplace_back(bd);
+    }
+  });
+  auto const bd_copy = ns_per_copy(branchDescriptions);
+  auto const pd_copy = ns_per_copy(productDescriptions);
+
+  // The ROOT transients, once used.
+  auto const transient_bytes = heap_bytes_of([&] {
+    for (auto const& pd : productDescriptions) {
+      pd.branchName();
+      pd.wrappedName();
+    }
+  });
+
+  // The framework structures built from the list.  The descriptions
+  // held by the tables are measured on their own, as built by them.
+  std::unique_ptr<ProductTables> tables;
+  auto const tables_bytes = heap_bytes_of(
+    [&] { tables = std::make_unique<ProductTables>(branchDescriptions); });
+  CoreDescriptionsByID cores;
+  auto const cores_bytes = heap_bytes_of([&] {
+    for (auto const& bd : branchDescriptions) {
+      cores.try_emplace(bd.productID(),
+                        std::make_shared<ProductDescription const>(bd));
+    }
+  });
+  std::unique_ptr<ProductTables> tables_copy;
+  auto const copy_bytes = heap_bytes_of(
+    [&] { tables_copy = std::make_unique<ProductTables>(*tables); });
+
+  std::cout << n << " products\n\n"
+            << std::fixed << std::setprecision(1) << std::left
+            << std::setw(34) << "" << std::right << std::setw(8) << "sizeof"
+            << std::setw(12) << "heap [KiB]" << std::setw(12) << "B/product"
+            << std::setw(12) << "copy [ns]" << '\n';
+  report("BranchDescription", sizeof(BranchDescription), bd_bytes, n, bd_copy);
+  report(
+    "ProductDescription", sizeof(ProductDescription), pd_bytes, n, pd_copy);
+  report("ProductDescription + transients",
+         sizeof(ProductDescription),
+         pd_bytes + transient_bytes,
+         n,
+         pd_copy);
+
+  std::cout << '\n'
+            << std::left << std::setw(34) << "" << std::right
+            << std::setw(8) << "" << std::setw(12) << "heap [KiB]"
+            << std::setw(12) << "B/product" << '\n';
+  auto report_heap = [n](char const* const what, long long const bytes) {
+    std::cout << std::left << std::setw(34) << what << std::right
+              << std::setw(8) << "" << std::setw(12) << bytes / 1024
+              << std::setw(12) << double(bytes) / n << '\n';
+  };
+  report_heap("ProductTables", tables_bytes);
+  report_heap("  of which ProductDescriptions", cores_bytes);
+  report_heap("copy of the ProductTables", copy_bytes);
+}
@@ -0,0 +1,95 @@
+#define BOOST_TEST_MODULE (ProductDescription_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Provenance/BranchDescription.h"
+#include "canvas/Persistency/Provenance/ProcessConfigurationID.h"
+#include "canvas/Persistency/Provenance/ProductDescription.h"
+#include "fhiclcpp/ParameterSetID.h"
+
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace art;
+
+// Descriptions are shared by address, and may not be modified.
+static_assert(std::is_copy_constructible_v<ProductDescription>);
+static_assert(!std::is_copy_assignable_v<ProductDescription>);
+
+namespace {
+  BranchDescription
+  make_description(std::string const& moduleLabel,
+                   std::string const& instance = "")
+  {
+    return BranchDescription{InSubRun,
+                             moduleLabel,
+                             "reco",
+                             "std::vector<art::Ptr<int> >",
+                             instance,
+                             fhicl::ParameterSetID{},
+                             ProcessConfigurationID{},
+                             BranchDescription::Transients::Produced,
+                             true,
+                             false};
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(ProductDescription_t)
+
+BOOST_AUTO_TEST_CASE(core_of_branch_description)
+{
+  auto const bd = make_description("a", "i");
+  ProductDescription const pd{bd};
+  BOOST_TEST(pd.moduleLabel() == bd.moduleLabel());
+  BOOST_TEST(pd.processName() == bd.processName());
+  BOOST_TEST(pd.producedClassName() == bd.producedClassName());
+  BOOST_TEST(pd.friendlyClassName() == bd.friendlyClassName());
+  BOOST_TEST(pd.productInstanceName() == bd.productInstanceName());
+  BOOST_TEST(pd.inputTag() == bd.inputTag());
+  BOOST_TEST(pd.productID() == bd.productID());
+  BOOST_TEST(pd.branchType() == bd.branchType());
+  BOOST_TEST(pd.supportsView() == bd.supportsView());
+  BOOST_TEST(pd.branchName() == bd.branchName());
+  BOOST_TEST(pd.wrappedName() == bd.wrappedName());
+  BOOST_TEST(sizeof(ProductDescription) < sizeof(BranchDescription));
+}
+
+BOOST_AUTO_TEST_CASE(shared_names)
+{
+  ProductDescription const a{make_description("a")};
+  ProductDescription const b{make_description("b")};
+  BOOST_TEST(&a.processName() == &b.processName());
+  BOOST_TEST(&a.producedClassName() == &b.producedClassName());
+  BOOST_TEST((a.internedFriendlyClassName() == b.internedFriendlyClassName()));
+  BOOST_TEST(&a.moduleLabel() != &b.moduleLabel());
+  BOOST_TEST((a != b));
+
+  auto const copy = a;
+  BOOST_TEST((copy == a));
+  BOOST_TEST(&copy.moduleLabel() == &a.moduleLabel());
+  BOOST_TEST(&copy.branchName() == &a.branchName());
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_first_use)
+{
+  ProductDescription const pd{make_description("c")};
+  std::vector<std::string const*> branchNames(8);
+  std::vector<std::string const*> wrappedNames(8);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i != branchNames.size(); ++i) {
+    threads.emplace_back([&pd, &branchNames, &wrappedNames, i] {
+      branchNames[i] = &pd.branchName();
+      wrappedNames[i] = &pd.wrappedName();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (std::size_t i = 1; i != branchNames.size(); ++i) {
+    BOOST_TEST(branchNames[i] == branchNames[0]);
+    BOOST_TEST(wrappedNames[i] == wrappedNames[0]);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,195 @@
+#define BOOST_TEST_MODULE (ProductLookups_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Provenance/BranchDescription.h"
+#include "canvas/Persistency/Provenance/ProcessConfigurationID.h"
+#include "canvas/Persistency/Provenance/ProductTables.h"
+#include "canvas/Persistency/Provenance/detail/createProductLookups.h"
+#include "canvas/Persistency/Provenance/detail/createViewLookups.h"
+#include "canvas/Utilities/FriendlyName.h"
+#include "canvas/Utilities/TypeID.h"
+#include "fhiclcpp/ParameterSetID.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// The product and view lookups of ProductTable are computed in flat,
+// interned tables, built all at once or key by key as products are
+// added.  This test compares them, over randomized sets of products,
+// with the nested maps of the original implementation.
+
+using namespace art;
+
+namespace reference {
+
+  struct CheapTag {
+    std::string label;
+    std::string instance;
+    std::string process;
+  };
+
+  bool
+  operator==(CheapTag const& left, CheapTag const& right)
+  {
+    return left.label == right.label && left.instance == right.instance &&
+           left.process == right.process;
+  }
+
+  struct PendingBTLEntry {
+    std::string fcn;
+    CheapTag ct;
+    ProductID pid;
+  };
+
+  ProductLookup_t
+  createProductLookups(ProductDescriptionsByID const& descriptions)
+  {
+    ProductLookup_t result;
+    std::vector<PendingBTLEntry> pendingEntries;
+    std::unordered_map<ProductID, CheapTag, ProductID::Hash> insertedABVs;
+    for (auto const& [pid, pd] : descriptions) {
+      auto const& procName = pd.processName();
+      result[pd.friendlyClassName()][procName].emplace_back(pid);
+
+      auto const& className = pd.producedClassName();
+      if (!is_assns(className)) {
+        continue;
+      }
+      CheapTag tag{pd.moduleLabel(), pd.productInstanceName(), procName};
+      auto const baseName = name_of_assns_base(className);
+      if (!baseName.empty()) {
+        pendingEntries.push_back(
+          {friendlyname::friendlyName(baseName), std::move(tag), pid});
+      } else {
+        insertedABVs.emplace(pid, std::move(tag));
+      }
+    }
+
+    auto const iend = insertedABVs.cend();
+    for (auto const& pe : pendingEntries) {
+      auto& pids = result[pe.fcn][pe.ct.process];
+      if (pids.empty() ||
+          !std::any_of(pids.cbegin(), pids.cend(), [&](ProductID const pid) {
+            auto const i = insertedABVs.find(pid);
+            return i != iend && pe.ct == i->second;
+          })) {
+        pids.emplace_back(pe.pid);
+      }
+    }
+    return result;
+  }
+
+  ViewLookup_t
+  createViewLookups(ProductDescriptionsByID const& descriptions)
+  {
+    ViewLookup_t result;
+    for (auto const& [pid, pd] : descriptions) {
+      if (pd.supportsView()) {
+        result[pd.processName()].emplace_back(pid);
+      }
+    }
+    return result;
+  }
+
+} // namespace reference
+
+namespace {
+
+  std::mt19937 rng{20231019};
+
+  template <typename T>
+  T const&
+  pick(std::vector<T> const& v)
+  {
+    return v[rng() % v.size()];
+  }
+
+  std::vector<std::string> const classNames{"std::vector<int>",
+                                            "double",
+                                            "art::Assns<A,B,void>",
+                                            "art::Assns<A,B,D>",
+                                            "art::Assns<A,B,E>",
+                                            "art::Assns<B,A,void>",
+                                            "art::Assns<B,A,D>",
+                                            "art::Assns<A,C,D>"};
+  std::vector<std::string> const labels{"a", "b", "m", "n"};
+  std::vector<std::string> const instances{"", "i"};
+  std::vector<std::string> const processes{"reco", "sim", "ana"};
+
+  // A set of distinct products of random class names, module labels,
+  // instance names and process names.
+  ProductDescriptions
+  randomDescriptions()
+  {
+    ProductDescriptions result;
+    ProductDescriptionsByID seen;
+    for (auto n = rng() % 40; n != 0; --n) {
+      BranchDescription bd{InEvent,
+                           pick(labels),
+                           pick(processes),
+                           pick(classNames),
+                           pick(instances),
+                           fhicl::ParameterSetID{},
+                           ProcessConfigurationID{},
+                           BranchDescription::Transients::Produced,
+                           rng() % 2 == 0,
+                           false};
+      if (seen.try_emplace(bd.productID(), bd).second) {
+        result.push_back(std::move(bd));
+      }
+    }
+    std::shuffle(result.begin(), result.end(), rng);
+    return result;
+  }
+
+  ProductDescriptionsByID
+  byID(ProductDescriptions const& descriptions)
+  {
+    ProductDescriptionsByID result;
+    for (auto const& pd : descriptions) {
+      result.try_emplace(pd.productID(), pd);
+    }
+    return result;
+  }
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(ProductLookups_t)
+
+BOOST_AUTO_TEST_CASE(all_at_once)
+{
+  for (unsigned i{}; i != 500; ++i) {
+    auto const descriptions = byID(randomDescriptions());
+    BOOST_TEST((detail::createProductLookups(descriptions).toMap() ==
+                reference::createProductLookups(descriptions)));
+    BOOST_TEST((detail::createViewLookups(descriptions).byProcess() ==
+                reference::createViewLookups(descriptions)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(incremental)
+{
+  for (unsigned i{}; i != 500; ++i) {
+    auto const descriptions = randomDescriptions();
+    ProductTable table{{}, InEvent};
+    for (auto b = descriptions.cbegin(); b != descriptions.cend();) {
+      auto const n = std::min<std::size_t>(1 + rng() % 5,
+                                           descriptions.cend() - b);
+      table.add({b, b + n}, InEvent);
+      b += n;
+      auto const expected = byID({descriptions.cbegin(), b});
+      auto const products = reference::createProductLookups(expected);
+      auto const views = reference::createViewLookups(expected);
+      BOOST_TEST((table.productLookupTable.toMap() == products));
+      BOOST_TEST((table.productLookup == products));
+      BOOST_TEST((table.viewLookupTable.byProcess() == views));
+      BOOST_TEST((table.viewLookup == views));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
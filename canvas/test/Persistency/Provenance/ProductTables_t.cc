@@ -0,0 +1,287 @@
+#define BOOST_TEST_MODULE (ProductTables_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Provenance/BranchDescription.h"
+#include "canvas/Persistency/Provenance/ProcessConfigurationID.h"
+#include "canvas/Persistency/Provenance/ProductTables.h"
+#include "canvas/Utilities/FriendlyName.h"
+#include "canvas/Utilities/InternedString.h"
+#include "fhiclcpp/ParameterSetID.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace art;
+
+namespace {
+  BranchDescription
+  make_description(std::string const& className,
+                   std::string const& moduleLabel,
+                   std::string const& instance,
+                   std::string const& process,
+                   bool const supportsView = false)
+  {
+    return BranchDescription{InEvent,
+                             moduleLabel,
+                             process,
+                             className,
+                             instance,
+                             fhicl::ParameterSetID{},
+                             ProcessConfigurationID{},
+                             BranchDescription::Transients::Produced,
+                             supportsView,
+                             false};
+  }
+
+  std::vector<ProductID>
+  to_vector(span<ProductID const> const pids)
+  {
+    return {pids.begin(), pids.end()};
+  }
+
+  ProductDescriptions const descriptions{
+    make_description("std::vector<int>", "a", "", "reco", true),
+    make_description("std::vector<int>", "b", "", "reco", true),
+    make_description("std::vector<int>", "a", "", "sim", true),
+    make_description("double", "a", "", "reco"),
+    make_description("double", "a", "", "sim", false),
+    // An Assns<A, B, void> and an Assns<A, B, D> of the same module
+    // label and instance name: only the former is found as an
+    // Assns<A, B>.
+    make_description("art::Assns<A,B,void>", "m", "", "reco"),
+    make_description("art::Assns<A,B,D>", "m", "", "reco"),
+    // An Assns<A, B, D> without an Assns<A, B, void>: it is also found
+    // as an Assns<A, B>.
+    make_description("art::Assns<A,B,D>", "n", "", "reco")};
+
+  ProductID
+  pid_of(std::size_t const i)
+  {
+    return descriptions[i].productID();
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(ProductTables_t)
+
+BOOST_AUTO_TEST_CASE(product_lookups)
+{
+  ProductTable const table{descriptions, InEvent};
+  auto const& products = table.productLookupTable;
+
+  auto const ints = products.productIDs("ints", "reco");
+  BOOST_TEST_REQUIRE(ints.size() == 2ull);
+  BOOST_TEST((to_vector(ints) == table.productLookup.at("ints").at("reco")));
+  BOOST_TEST(to_vector(products.productIDs("ints", "sim")) ==
+             std::vector{pid_of(2)});
+  BOOST_TEST(to_vector(products.productIDs("double", "sim")) ==
+             std::vector{pid_of(4)});
+
+  auto const abFCN = friendlyname::friendlyName("art::Assns<A,B,void>");
+  auto const abd = products.productIDs(abFCN, "reco");
+  BOOST_TEST_REQUIRE(abd.size() == 2ull);
+  BOOST_TEST(abd[0] == pid_of(5));
+  BOOST_TEST(abd[1] == pid_of(7));
+  BOOST_TEST(products.entries(abFCN).size() == 1ull);
+  BOOST_TEST(products.entries(InternedString{"ints"}).size() == 2ull);
+
+  BOOST_TEST(products.productIDs("ints", "no such process").empty());
+  BOOST_TEST(products.productIDs("no such class", "reco").empty());
+  BOOST_TEST(products.entries("no such class").empty());
+}
+
+BOOST_AUTO_TEST_CASE(compatibility_maps)
+{
+  ProductTable const table{descriptions, InEvent};
+  auto const& map = table.productLookup;
+  BOOST_TEST(map.size() == 4ull);
+  BOOST_TEST(table.productLookupTable.entries().size() == 6ull);
+  for (auto const& entry : table.productLookupTable.entries()) {
+    BOOST_TEST(to_vector(table.productLookupTable.productIDs(entry)) ==
+               map.at(entry.friendlyClassName.str())
+                 .at(entry.processName.str()));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(view_lookups)
+{
+  ProductTable const table{descriptions, InEvent};
+  auto const& views = table.viewLookupTable;
+  BOOST_TEST(to_vector(views.productIDs("", "reco")) ==
+             table.viewLookup.at("reco"));
+  BOOST_TEST(views.productIDs("", "reco").size() == 2ull);
+  BOOST_TEST(to_vector(views.productIDs("", "sim")) == std::vector{pid_of(2)});
+  BOOST_TEST(table.viewLookup.size() == 2ull);
+}
+
+BOOST_AUTO_TEST_CASE(other_branch_types)
+{
+  ProductTable const table{descriptions, InRun};
+  BOOST_TEST(table.productLookupTable.empty());
+  BOOST_TEST(table.viewLookupTable.empty());
+  BOOST_TEST(table.productLookup.empty());
+}
+
+BOOST_AUTO_TEST_CASE(incremental_additions)
+{
+  ProductTable const full{descriptions, InEvent};
+  for (std::size_t n{}; n <= descriptions.size(); ++n) {
+    ProductDescriptions const first(descriptions.cbegin(),
+                                    descriptions.cbegin() + n);
+    ProductDescriptions const rest(descriptions.cbegin() + n,
+                                   descriptions.cend());
+    ProductTable table{first, InEvent};
+    table.add(rest, InEvent);
+    BOOST_TEST((table.productLookupTable.toMap() ==
+                full.productLookupTable.toMap()));
+    BOOST_TEST((table.productLookup == full.productLookup));
+    BOOST_TEST((table.viewLookupTable.byProcess() ==
+                full.viewLookupTable.byProcess()));
+    BOOST_TEST((table.viewLookup == full.viewLookup));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(one_at_a_time_additions)
+{
+  // Each addition supersedes the product IDs of one key, so that the
+  // table is compacted several times.
+  ProductDescriptions all{descriptions};
+  for (int i = 0; i != 50; ++i) {
+    auto const label = "v" + std::to_string(i);
+    all.push_back(make_description("std::vector<int>", label, "", "reco"));
+  }
+  ProductTable const full{all, InEvent};
+  ProductTable table{{}, InEvent};
+  for (auto const& pd : all) {
+    table.add({pd}, InEvent);
+    BOOST_TEST_REQUIRE(!!table.description(pd.productID()));
+  }
+  BOOST_TEST((table.productLookupTable.toMap() ==
+              full.productLookupTable.toMap()));
+  BOOST_TEST((table.productLookup == full.productLookup));
+  BOOST_TEST((table.viewLookupTable.byProcess() ==
+              full.viewLookupTable.byProcess()));
+  BOOST_TEST((table.viewLookup == full.viewLookup));
+}
+
+BOOST_AUTO_TEST_CASE(untouched_entries)
+{
+  // The entries of keys without added products are left as they are.
+  ProductTable table{descriptions, InEvent};
+  auto const entries_of = [&table](std::string const& fcn) {
+    auto const entries = table.productLookupTable.entries(fcn);
+    return std::vector<ProductLookupTable::Entry>(entries.begin(),
+                                                  entries.end());
+  };
+  auto const doubles = entries_of("double");
+  BOOST_TEST_REQUIRE(doubles.size() == 2ull);
+  table.add({make_description("std::vector<int>", "c", "", "reco", true)},
+            InEvent);
+  auto const after = entries_of("double");
+  BOOST_TEST_REQUIRE(after.size() == doubles.size());
+  for (std::size_t i{}; i != after.size(); ++i) {
+    BOOST_TEST(after[i].begin == doubles[i].begin);
+    BOOST_TEST(after[i].end == doubles[i].end);
+  }
+  BOOST_TEST(table.productLookupTable.productIDs("ints", "reco").size() ==
+             3ull);
+}
+
+BOOST_AUTO_TEST_CASE(duplicate_additions)
+{
+  ProductTable table{descriptions, InEvent};
+  auto const before = table.productLookup;
+  table.add(descriptions, InEvent);
+  BOOST_TEST(table.descriptions.size() == descriptions.size());
+  BOOST_TEST((table.productLookup == before));
+  BOOST_TEST(table.productLookupTable.entries().size() == 6ull);
+}
+
+BOOST_AUTO_TEST_CASE(added_assns_void)
+{
+  // Adding the Assns<A, B, void> of the module label "n" removes the
+  // Assns<A, B, D> of the same label from the Assns<A, B> lookup.
+  ProductTable table{descriptions, InEvent};
+  auto const abFCN = friendlyname::friendlyName("art::Assns<A,B,void>");
+  BOOST_TEST(table.productLookupTable.productIDs(abFCN, "reco").size() ==
+             2ull);
+  auto const abv = make_description("art::Assns<A,B,void>", "n", "", "reco");
+  table.add({abv}, InEvent);
+  auto const abd = table.productLookupTable.productIDs(abFCN, "reco");
+  BOOST_TEST((to_vector(abd) == table.productLookup.at(abFCN).at("reco")));
+  auto pids = to_vector(abd);
+  std::sort(pids.begin(), pids.end());
+  auto expected = std::vector{pid_of(5), abv.productID()};
+  std::sort(expected.begin(), expected.end());
+  BOOST_TEST(pids == expected);
+}
+
+BOOST_AUTO_TEST_CASE(all_branch_types)
+{
+  ProductTables tables{ProductDescriptions(descriptions.cbegin(),
+                                           descriptions.cbegin() + 4)};
+  tables.add(descriptions);
+  ProductTable const full{descriptions, InEvent};
+  BOOST_TEST((tables.get(InEvent).productLookup == full.productLookup));
+  BOOST_TEST(tables.get(InRun).productLookup.empty());
+}
+
+BOOST_AUTO_TEST_CASE(description_lookups)
+{
+  ProductTable table{descriptions, InEvent};
+  for (auto const& [pid, pd] : table.descriptions) {
+    BOOST_TEST(table.description(pid).get() == &pd);
+  }
+  BOOST_TEST(!table.description(ProductID{}));
+  BOOST_TEST(!ProductTable{}.description(pid_of(0)));
+
+  // Addresses of descriptions already found are unaffected by
+  // additions.
+  auto const first = table.description(pid_of(0));
+  ProductDescriptions more;
+  for (int i = 0; i != 100; ++i) {
+    more.push_back(
+      make_description("double", "x" + std::to_string(i), "", "reco"));
+  }
+  table.add(more, InEvent);
+  BOOST_TEST((table.description(pid_of(0)) == first));
+  for (auto const& pd : more) {
+    BOOST_TEST_REQUIRE(!!table.description(pd.productID()));
+    BOOST_TEST(table.description(pd.productID())->moduleLabel() ==
+               pd.moduleLabel());
+  }
+
+  // A copy refers to its own descriptions.
+  ProductTable const copy{table};
+  for (auto const& [pid, pd] : copy.descriptions) {
+    BOOST_TEST(copy.description(pid).get() == &pd);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(core_descriptions)
+{
+  ProductTable table{descriptions, InEvent};
+  BOOST_TEST(table.coreDescriptions.size() == table.descriptions.size());
+  for (auto const& [pid, bd] : table.descriptions) {
+    auto const pd = table.coreDescription(pid);
+    BOOST_TEST_REQUIRE(!!pd);
+    BOOST_TEST(pd->productID() == pid);
+    BOOST_TEST(pd->moduleLabel() == bd.moduleLabel());
+    BOOST_TEST(pd->friendlyClassName() == bd.friendlyClassName());
+    BOOST_TEST(pd->processName() == bd.processName());
+  }
+  BOOST_TEST(!table.coreDescription(ProductID{}));
+
+  // Copies of the table share its descriptions.
+  ProductTable const copy{table};
+  for (auto const& [pid, pd] : table.coreDescriptions) {
+    BOOST_TEST(copy.coreDescription(pid).get() == pd.get());
+  }
+
+  table.add({make_description("float", "f", "", "reco")}, InEvent);
+  BOOST_TEST(table.coreDescriptions.size() == table.descriptions.size());
+  BOOST_TEST(table.productLookupTable.productIDs("float", "reco").size() ==
+             1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
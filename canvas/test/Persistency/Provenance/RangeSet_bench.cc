@@ -0,0 +1,101 @@
+// vim: set sw=2 expandtab :
+
+// Times RangeSet::checksum() for RangeSets of N ranges, N given on the
+// command line (default: 10, 1k and 100k), comparing:
+//
+//   - the crc32 of to_compact_string(), as formerly computed on every
+//     call,
+//   - repeated calls to checksum() on an unchanged RangeSet, and
+//   - a call to checksum() after each update(), as when the RangeSet
+//     of a product is recorded for every event of a subrun.
+
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Persistency/Provenance/RangeSet.h"
+#include "cetlib/crc32.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace art;
+
+namespace {
+
+  constexpr unsigned calls{1000};
+
+  // Every other event, so that each event yields a separate range.
+  std::vector<EventID>
+  make_events(std::size_t const n)
+  {
+    std::vector<EventID> result;
+    result.reserve(n);
+    for (EventNumber_t e = 1; result.size() < n; e += 2) {
+      result.emplace_back(1, e / 1000, e);
+    }
+    return result;
+  }
+
+  template <typename F>
+  double
+  time_ns(F f)
+  {
+    auto const start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::nano> const elapsed{
+      std::chrono::steady_clock::now() - start};
+    return elapsed.count();
+  }
+
+  void
+  report(std::size_t const n, char const* what, double const ns)
+  {
+    std::cout << std::setw(10) << n << "  " << std::left << std::setw(32)
+              << what << std::right << std::setw(14) << std::fixed
+              << std::setprecision(1) << ns << " ns/call\n";
+  }
+
+} // unnamed namespace
+
+int
+main(int argc, char** argv)
+{
+  std::vector<std::size_t> sizes;
+  for (int i = 1; i < argc; ++i) {
+    sizes.push_back(std::strtoull(argv[i], nullptr, 10));
+  }
+  if (sizes.empty()) {
+    sizes = {10, 1'000, 100'000};
+  }
+
+  unsigned sink{};
+  for (auto const n : sizes) {
+    auto const events = make_events(n);
+    RangeSet rs{RangeSet::invalid()};
+    for (auto const& id : events) {
+      rs.update(id);
+    }
+
+    report(n, "crc32 of to_compact_string()", time_ns([&rs, &sink] {
+             for (unsigned i = 0; i != calls; ++i) {
+               sink += cet::crc32{rs.to_compact_string()}.digest();
+             }
+           }) / calls);
+    report(n, "checksum() (unchanged)", time_ns([&rs, &sink] {
+             for (unsigned i = 0; i != calls; ++i) {
+               sink += rs.checksum();
+             }
+           }) / calls);
+
+    RangeSet growing{RangeSet::invalid()};
+    report(n, "update() + checksum()", time_ns([&events, &growing, &sink] {
+             for (auto const& id : events) {
+               growing.update(id);
+               sink += growing.checksum();
+             }
+           }) / n);
+  }
+  // Keep the checksums from being optimized away.
+  return sink == 0 ? 1 : 0;
+}
@@ -1,12 +1,19 @@
 #define BOOST_TEST_MODULE (RangeSet_t)
 #include "boost/test/unit_test.hpp"
+#include "canvas/Persistency/Provenance/EventID.h"
 #include "canvas/Persistency/Provenance/RangeSet.h"
 #include "canvas/Persistency/Provenance/RunID.h"
+#include "cetlib/crc32.h"
+
+#include <algorithm>
 
 #include <iostream>
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace std::string_literals;
+using art::EventID;
 using art::EventRange;
 using art::RangeSet;
 using art::RunID;
@@ -336,6 +343,149 @@ BOOST_AUTO_TEST_CASE(overlapping_ranges)
   BOOST_TEST(art::overlapping_ranges(rs2, rs1));
 }
 
+BOOST_AUTO_TEST_CASE(fragmented)
+{
+  // Every other event of many subruns, as produced by the
+  // concatenation of files with interleaved events.
+  RangeSet odd{3};
+  RangeSet even{3};
+  for (unsigned sr = 1; sr < 40; sr += 2) {
+    for (unsigned e = 1; e < 200; ++e) {
+      (e % 2 ? odd : even).update(EventID{3, sr, e});
+    }
+  }
+  odd.collapse();
+  even.collapse();
+  BOOST_TEST_REQUIRE(odd.ranges().size() == 20u * 100u);
+  BOOST_TEST(art::disjoint_ranges(odd, even));
+  BOOST_TEST(!art::overlapping_ranges(even, odd));
+
+  auto linear_contains = [](RangeSet const& rs, unsigned sr, unsigned e) {
+    return std::any_of(rs.begin(), rs.end(), [sr, e](auto const& range) {
+      return range.contains(sr, e);
+    });
+  };
+  for (unsigned sr = 0; sr != 42; ++sr) {
+    for (unsigned e = 0; e != 202; ++e) {
+      BOOST_TEST(odd.contains(3, sr, e) == linear_contains(odd, sr, e));
+      BOOST_TEST(even.contains(3, sr, e) == linear_contains(even, sr, e));
+    }
+  }
+  BOOST_TEST(odd.next_subrun_or_end(0) == 100u);
+
+  // Events appended after collapsing must still be found.
+  odd.update(EventID{3, 1, 301});
+  odd.update(EventID{3, 0, 7});
+  BOOST_TEST(odd.contains(3, 1, 301));
+  BOOST_TEST(odd.contains(3, 0, 7));
+  auto const split = odd.split_range(0, 7);
+  BOOST_TEST(!split.second);
+  odd.sort();
+  odd.collapse();
+  BOOST_TEST(odd.contains(3, 0, 7));
+
+  RangeSet merged{even};
+  merged.merge(RangeSet{3, {EventRange{41, 1, 5}}});
+  merged.merge(odd);
+  BOOST_TEST(merged.ranges().size() == 20u + 3u);
+  BOOST_TEST(merged.contains(3, 0, 7));
+  BOOST_TEST(merged.contains(3, 39, 199));
+  BOOST_TEST(merged.contains(3, 41, 4));
+  BOOST_TEST(!merged.contains(3, 2, 1));
+  BOOST_TEST(art::overlapping_ranges(merged, odd));
+  BOOST_TEST(!art::disjoint_ranges(even, merged));
+}
+
+BOOST_AUTO_TEST_CASE(updating_after_collapse)
+{
+  RangeSet rs{1};
+  rs.update(EventID{1, 2, 1});
+  rs.update(EventID{1, 2, 2});
+  rs.collapse();
+  BOOST_TEST(rs.is_collapsed());
+
+  // An out-of-order event leaves the RangeSet marked as collapsed, so
+  // that collapsing it again does nothing, as it always has.
+  rs.update(EventID{1, 1, 5});
+  BOOST_TEST(rs.is_collapsed());
+  BOOST_CHECK_NO_THROW(rs.collapse());
+  BOOST_TEST_REQUIRE(rs.ranges().size() == 2u);
+  BOOST_TEST(rs.contains(1, 1, 5));
+  BOOST_TEST(rs.contains(1, 2, 2));
+  BOOST_TEST(!rs.contains(1, 2, 3));
+}
+
+BOOST_AUTO_TEST_CASE(checksums)
+{
+  auto reference = [](RangeSet const& rs) {
+    return cet::crc32{rs.to_compact_string()}.digest();
+  };
+  RangeSet rs{RangeSet::invalid()};
+  BOOST_TEST(rs.checksum() == reference(rs));
+  for (unsigned e = 1; e != 20; ++e) {
+    if (e % 5 != 0) {
+      rs.update(EventID{2, 1 + e / 10, e});
+    }
+    BOOST_TEST(rs.checksum() == reference(rs));
+  }
+  rs.emplace_range(3, 7, 12);
+  rs.emplace_range(3, 12, 15);
+  BOOST_TEST(rs.checksum() == reference(rs));
+  rs.collapse();
+  BOOST_TEST(rs.checksum() == reference(rs));
+  rs.split_range(1, 2);
+  BOOST_TEST(rs.checksum() == reference(rs));
+  rs.merge(RangeSet{2, {EventRange{1, 5, 6}, EventRange{4, 1, 2}}});
+  BOOST_TEST(rs.checksum() == reference(rs));
+  rs.at(2).set_end(18);
+  BOOST_TEST(rs.checksum() == reference(rs));
+  rs.front().set_end(3);
+  BOOST_TEST(rs.checksum() == reference(rs));
+  rs.set_run(3);
+  BOOST_TEST(rs.checksum() == reference(rs));
+  rs.clear();
+  BOOST_TEST(rs.checksum() == reference(rs));
+
+  auto const full = RangeSet::forRun(RunID{4});
+  BOOST_TEST(full.checksum() == reference(full));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_checksums)
+{
+  // The checksum cache of a const RangeSet is filled by whichever
+  // caller gets there first, while others copy the RangeSet.
+  RangeSet rs{5};
+  for (unsigned e = 1; e != 2000; ++e) {
+    if (e % 3 != 0) {
+      rs.update(EventID{5, 1 + e / 100, e});
+    }
+  }
+  auto const expected = cet::crc32{rs.to_compact_string()}.digest();
+  RangeSet const& crs = rs;
+
+  unsigned const n_threads{4};
+  std::vector<std::vector<unsigned>> results(n_threads);
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i != n_threads; ++i) {
+    threads.emplace_back([&crs, &result = results[i]] {
+      for (unsigned j = 0; j != 50; ++j) {
+        result.push_back(crs.checksum());
+        RangeSet const copy{crs};
+        result.push_back(copy.checksum());
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto const& result : results) {
+    BOOST_TEST(result.size() == 100u);
+    BOOST_TEST(std::all_of(result.cbegin(), result.cend(), [=](unsigned c) {
+      return c == expected;
+    }));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(invalid)
 {
   auto const rs1 = RangeSet::invalid();
@@ -0,0 +1,295 @@
+#define BOOST_TEST_MODULE (FriendlyName_corpus_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Utilities/Exception.h"
+#include "canvas/Utilities/FriendlyName.h"
+
+#include <cstddef>
+#include <exception>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+// Friendly names are part of the branch names of existing files.  This
+// test compares friendlyName() with the original, regular-expression-
+// based implementation over a corpus of generated type names, and of
+// strings made of the pieces such names are made of.
+//
+// The original implementation interpreted parts of type names as
+// regular expressions; names containing characters special to them
+// (e.g. the '*' of a pointer, or the parentheses of an anonymous
+// namespace within a template argument) are not compared.
+
+namespace reference {
+
+  std::regex const reAllSpaces{" +"};
+  std::regex const reAssns{"art::Assns"};
+  std::regex const reBeginSpace{"^ +"};
+  std::regex const reComma{","};
+  std::regex const reEndSpace{" +$"};
+  std::regex const reParens{"(\\(|\\))"};
+  std::regex const reFirstTwoArgs{"^([^,]+),([^,]+)"};
+  std::regex const reLong{"long "};
+  std::regex const reLongLong{"Long64_t"};
+  std::regex const reMapVector{"cet::map_vector"};
+  std::regex const reMapVectorKey{"cet::map_vector_key"};
+  std::regex const reString{"(?:std::basic_string<char>|std::string)"};
+  std::regex const reTemplateArgs{"([^<]*)<(.*)>$"};
+  std::regex const reTemplateClass{"([^<>,]+<[^<>]*>)"};
+  std::regex const reULongLong{"ULong64_t"};
+  std::regex const reUnsigned{"unsigned "};
+  std::regex const reVector{"std::vector"};
+  std::regex const reWrapper{"art::Wrapper<(.*)>"};
+
+  std::string const emptyString{};
+
+  std::string
+  removeExtraSpaces(std::string const& in)
+  {
+    return std::regex_replace(std::regex_replace(in, reBeginSpace, emptyString),
+                              reEndSpace,
+                              emptyString);
+  }
+
+  std::string
+  removeAllSpaces(std::string const& in)
+  {
+    return std::regex_replace(in, reAllSpaces, emptyString);
+  }
+
+  std::string
+  escapeParens(std::string const& in)
+  {
+    return std::regex_replace(in, reParens, "\\$1");
+  }
+
+  std::string
+  standardRenames(std::string const& in)
+  {
+    std::string name{std::regex_replace(in, reWrapper, "$1")};
+    name = std::regex_replace(name, reString, "String");
+    name = std::regex_replace(name, reUnsigned, "u");
+    name = std::regex_replace(name, reLong, "l");
+    name = std::regex_replace(name, reULongLong, "ull");
+    name = std::regex_replace(name, reLongLong, "ll");
+    name = std::regex_replace(name, reVector, "s");
+    name = std::regex_replace(name, reMapVectorKey, "mvk");
+    name = std::regex_replace(name, reMapVector, "mv");
+    return name;
+  }
+
+  std::string handleTemplateArguments(std::string const&, std::string const&);
+  std::string
+  subFriendlyName(std::string const& iFullName)
+  {
+    std::string result{removeExtraSpaces(iFullName)};
+    std::smatch theMatch;
+    if (std::regex_match(result, theMatch, reTemplateArgs)) {
+      std::string const cMatch{theMatch.str(1)};
+      std::string const aMatch{theMatch.str(2)};
+      std::string const theSub{handleTemplateArguments(cMatch, aMatch)};
+      std::regex const eMatch{std::string{"^"} + escapeParens(cMatch) + '<' +
+                              escapeParens(aMatch) + '>'};
+      result = std::regex_replace(result, eMatch, theSub + cMatch);
+    }
+    return result;
+  }
+
+  void
+  maybeSwapFirstTwoArgs(std::string& result)
+  {
+    std::smatch theMatch;
+    if (std::regex_search(result, theMatch, reFirstTwoArgs) &&
+        (theMatch.str(1) > theMatch.str(2))) {
+      result = std::regex_replace(result, reFirstTwoArgs, "$2,$1");
+    }
+  }
+
+  std::string
+  handleTemplateArguments(std::string const& cName, std::string const& tArgs)
+  {
+    std::string result{removeExtraSpaces(tArgs)};
+    while (std::string::npos != result.find_first_of("<")) {
+      std::smatch theMatch;
+      std::string replaced;
+      if (std::regex_search(result, theMatch, reTemplateClass)) {
+        std::string const templateClass{theMatch.str(1)};
+        std::string const friendlierName{
+          removeAllSpaces(subFriendlyName(templateClass))};
+        replaced =
+          std::regex_replace(result, std::regex(templateClass), friendlierName);
+      }
+      // Where the original implementation looped forever, this one
+      // throws.
+      if (replaced.empty() || replaced == result) {
+        throw art::Exception(art::errors::LogicError)
+          << "No template match for \"" << result << '"';
+      }
+      result = std::move(replaced);
+    }
+    if (std::regex_match(cName, reAssns)) {
+      maybeSwapFirstTwoArgs(result);
+    }
+    result = std::regex_replace(result, reComma, emptyString);
+    return result;
+  }
+
+  std::string
+  friendlyName(std::string const& iFullName)
+  {
+    return subFriendlyName(standardRenames(iFullName));
+  }
+
+} // namespace reference
+
+namespace {
+
+  std::mt19937 rng{20231018};
+
+  std::size_t
+  pick(std::size_t const n)
+  {
+    return rng() % n;
+  }
+
+  std::vector<std::string> const leaves{"int",
+                                        "float",
+                                        "unsigned int",
+                                        "long",
+                                        "unsigned long long",
+                                        "long double",
+                                        "long long",
+                                        "signed char",
+                                        "ULong64_t",
+                                        "Long64_t",
+                                        "std::string",
+                                        "std::basic_string<char>",
+                                        "cet::map_vector_key",
+                                        "recob::Hit",
+                                        "sim::MCParticle",
+                                        "Aa",
+                                        "Bb",
+                                        "ns::Aa",
+                                        "3"};
+
+  struct Template {
+    std::string name;
+    unsigned nargs;
+  };
+  std::vector<Template> const templates{{"std::vector", 1},
+                                        {"std::vector", 2},
+                                        {"art::Ptr", 1},
+                                        {"art::PtrVector", 1},
+                                        {"art::Assns", 2},
+                                        {"art::Assns", 3},
+                                        {"art::Wrapper", 1},
+                                        {"cet::map_vector", 1},
+                                        {"std::map", 2},
+                                        {"std::pair", 2},
+                                        {"std::array", 2},
+                                        {"std::tuple", 3},
+                                        {"A", 1},
+                                        {"ns::A", 1},
+                                        {"V", 2}};
+
+  // A type name, written with or without a space after each comma and
+  // before each closing '>' that follows another.
+  std::string
+  typeName(unsigned const depth, unsigned const style)
+  {
+    if (depth == 0 || pick(3) == 0) {
+      return leaves[pick(leaves.size())];
+    }
+    auto const& t = templates[pick(templates.size())];
+    auto result = t.name + '<';
+    for (unsigned i{}; i != t.nargs; ++i) {
+      if (i != 0) {
+        result += (style & 1) ? ", " : ",";
+      }
+      result += typeName(depth - 1, style);
+    }
+    if (result.back() == '>' && !(style & 2)) {
+      result += ' ';
+    }
+    result += '>';
+    if (pick(10) == 0) {
+      result += " const";
+    }
+    return result;
+  }
+
+  // A string of pieces of type names.
+  std::string
+  fuzzedName()
+  {
+    static std::vector<std::string> const pieces{"A",
+                                                 "B",
+                                                 "s",
+                                                 "<",
+                                                 ">",
+                                                 ",",
+                                                 " ",
+                                                 "art::Assns",
+                                                 "art::Wrapper<",
+                                                 "std::vector",
+                                                 "unsigned ",
+                                                 "long ",
+                                                 "Long64_t",
+                                                 "cet::map_vector",
+                                                 "_key",
+                                                 "std::string"};
+    std::string result;
+    for (auto n = pick(14); n != 0; --n) {
+      result += pieces[pick(pieces.size())];
+    }
+    return result;
+  }
+
+  template <typename F>
+  std::string
+  result_of(F f, std::string const& name)
+  {
+    try {
+      return f(name);
+    }
+    catch (std::exception const&) {
+      return "<exception>";
+    }
+  }
+
+}
+
+BOOST_AUTO_TEST_SUITE(FriendlyName_corpus_t)
+
+BOOST_AUTO_TEST_CASE(corpus)
+{
+  std::vector<std::string> corpus{"Foo",
+                                  "",
+                                  "<>",
+                                  "  std::vector<int>  ",
+                                  "std::pair<A<b>,ns::A<b> >",
+                                  "std::pair<A<b>, xA<b> >",
+                                  "art::Assns<A<b>,ns::A<b>,void>",
+                                  "A<b>c<d>",
+                                  "x<A<b>c<d> >"};
+  for (unsigned i{}; i != 5000; ++i) {
+    corpus.push_back(typeName(1 + pick(5), pick(4)));
+  }
+  for (unsigned i{}; i != 20000; ++i) {
+    corpus.push_back(fuzzedName());
+  }
+
+  std::size_t differences{};
+  for (auto const& name : corpus) {
+    auto const expected = result_of(reference::friendlyName, name);
+    auto const actual = result_of(art::friendlyname::friendlyName, name);
+    if (actual != expected && ++differences <= 10) {
+      BOOST_ERROR('"' << name << "\": \"" << actual << "\", expected \""
+                      << expected << '"');
+    }
+  }
+  BOOST_TEST(differences == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -36,6 +36,20 @@ FriendlyNameTestFixture::FriendlyNameTestFixture() : nameMap()
   nameMap.try_emplace("cet::map_vector<Foo>", "Foomv");
   nameMap.try_emplace("art::Assns<Ll,Rr,Dd>", "LlRrDdart::Assns");
   nameMap.try_emplace("art::Assns<Rr,Ll,Dd>", "LlRrDdart::Assns");
+  // Friendly names are part of the branch names of existing files, so
+  // the following must not change, however surprising.
+  nameMap.try_emplace("std::vector<unsigned long long>", "ullongs");
+  nameMap.try_emplace("std::vector<std::vector<signed char> >",
+                      "signedcharss");
+  nameMap.try_emplace(
+    "std::map<std::string,std::vector<std::basic_string<char> > >",
+    "StringStringsstd::map");
+  nameMap.try_emplace("std::vector<(anonymous namespace)::Foo>",
+                      "(anonymous namespace)::Foos");
+  nameMap.try_emplace("std::pair<A<b>,ns::A<b> >", "bAns::bAstd::pair");
+  nameMap.try_emplace("std::vector<int*>", "int*s");
+  nameMap.try_emplace("std::pair<std::vector<int>, std::vector<int> >",
+                      "ints intsstd::pair");
 }
 
 BOOST_FIXTURE_TEST_SUITE(FriendlyName_t, FriendlyNameTestFixture)
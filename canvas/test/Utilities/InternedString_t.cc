@@ -0,0 +1,54 @@
+#define BOOST_TEST_MODULE (InternedString_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Utilities/InternedString.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using art::InternedString;
+
+BOOST_AUTO_TEST_SUITE(InternedString_t)
+
+BOOST_AUTO_TEST_CASE(equality)
+{
+  std::string const name{"recob::Hits"};
+  InternedString const a{name};
+  InternedString const b{std::string{"recob::"} + "Hits"};
+  BOOST_TEST((a == b));
+  BOOST_TEST(&a.str() == &b.str());
+  BOOST_TEST(a.str() == name);
+  BOOST_TEST((a != InternedString{"recob::Tracks"}));
+  BOOST_TEST((InternedString{} == InternedString{""}));
+  BOOST_TEST(InternedString{}.str().empty());
+}
+
+BOOST_AUTO_TEST_CASE(find)
+{
+  BOOST_TEST(!InternedString::find("never interned"));
+  InternedString const interned{"interned"};
+  auto const found = InternedString::find("interned");
+  BOOST_TEST_REQUIRE(found.has_value());
+  BOOST_TEST((*found == interned));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+  constexpr unsigned n_threads{8};
+  std::vector<std::string const*> addresses(n_threads);
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i < n_threads; ++i) {
+    threads.emplace_back([i, &addresses] {
+      addresses[i] = &InternedString{"shared by all threads"}.str();
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto const* address : addresses) {
+    BOOST_TEST(address == addresses.front());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,83 @@
+// vim: set sw=2 expandtab :
+
+// Times TypeID::className() when called simultaneously from T threads,
+// T given on the command line (default: 1, 2, 4, 8, 16, 32 and 64),
+// each looking up the names of a fixed set of types repeatedly.
+
+#include "canvas/Utilities/TypeID.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace art;
+
+namespace {
+
+  constexpr unsigned calls_per_thread{200'000};
+
+  std::vector<TypeID> const types{TypeID{typeid(int)},
+                                  TypeID{typeid(double)},
+                                  TypeID{typeid(std::string)},
+                                  TypeID{typeid(std::vector<int>)},
+                                  TypeID{typeid(std::vector<std::string>)},
+                                  TypeID{typeid(std::map<int, double>)},
+                                  TypeID{typeid(std::pair<int, float>)},
+                                  TypeID{typeid(TypeID)}};
+
+  double
+  ns_per_call(unsigned const n_threads)
+  {
+    std::atomic<unsigned> ready{};
+    std::atomic<bool> go{false};
+    std::atomic<std::size_t> sink{};
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t != n_threads; ++t) {
+      threads.emplace_back([&ready, &go, &sink] {
+        ++ready;
+        while (!go) {
+        }
+        std::size_t total{};
+        for (unsigned i = 0; i != calls_per_thread; ++i) {
+          total += types[i % types.size()].className().size();
+        }
+        sink += total;
+      });
+    }
+    while (ready != n_threads) {
+    }
+    auto const start = std::chrono::steady_clock::now();
+    go = true;
+    for (auto& t : threads) {
+      t.join();
+    }
+    std::chrono::duration<double, std::nano> const elapsed{
+      std::chrono::steady_clock::now() - start};
+    return elapsed.count() / (double(n_threads) * calls_per_thread);
+  }
+
+} // unnamed namespace
+
+int
+main(int argc, char** argv)
+{
+  std::vector<unsigned> thread_counts;
+  for (int i = 1; i < argc; ++i) {
+    thread_counts.push_back(std::strtoul(argv[i], nullptr, 10));
+  }
+  if (thread_counts.empty()) {
+    thread_counts = {1, 2, 4, 8, 16, 32, 64};
+  }
+  for (auto const n : thread_counts) {
+    std::cout << std::setw(4) << n << " threads  " << std::fixed
+              << std::setprecision(1) << std::setw(10) << ns_per_call(n)
+              << " ns/call\n";
+  }
+}
@@ -5,7 +5,10 @@
 #include "canvas/Utilities/TypeID.h"
 
 #include <iostream>
+#include <map>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace arttest {
   struct empty {};
@@ -64,4 +67,28 @@ BOOST_AUTO_TEST_CASE(TypeID_type)
   BOOST_TEST(os.is_equal("arttest::also_empty"));
 }
 
+BOOST_AUTO_TEST_CASE(TypeID_className_interned)
+{
+  art::TypeID const id1{typeid(std::map<int, std::string>)};
+  art::TypeID const id2{typeid(std::map<int, std::string>)};
+  auto const& name = id1.className();
+  BOOST_TEST(name == "std::map<int,std::string>");
+  BOOST_TEST(&id2.className() == &name);
+
+  // Concurrent first requests for a name must all see the same string.
+  art::TypeID const id3{typeid(std::vector<arttest::also_empty>)};
+  std::vector<std::string const*> names(8);
+  std::vector<std::thread> threads;
+  for (auto& result : names) {
+    threads.emplace_back([&id3, &result] { result = &id3.className(); });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto const* p : names) {
+    BOOST_TEST(p == names.front());
+  }
+  BOOST_TEST(*names.front() == "std::vector<arttest::also_empty>");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
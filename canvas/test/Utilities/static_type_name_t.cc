@@ -0,0 +1,152 @@
+#define BOOST_TEST_MODULE (static_type_name_t)
+#include "boost/test/unit_test.hpp"
+
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/PtrVector.h"
+#include "canvas/Persistency/Common/Wrapper.h"
+#include "canvas/Persistency/Provenance/TypeLabel.h"
+#include "canvas/Utilities/FriendlyName.h"
+#include "canvas/Utilities/TypeID.h"
+#include "canvas/Utilities/static_type_name.h"
+#include "canvas/Utilities/uniform_type_name.h"
+
+#include <array>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace arttest {
+  struct Hit {};
+  struct Track {};
+  enum class Kind { a, b };
+  namespace detail {
+    struct Cluster {};
+  }
+  template <typename T>
+  struct Holder {};
+}
+
+namespace {
+  struct Hidden {};
+}
+
+using namespace art;
+using arttest::Hit;
+using arttest::Track;
+
+namespace {
+  // The static names must be those computed at run time from the
+  // type_info.
+  template <typename... Ts>
+  void
+  check_names()
+  {
+    (
+      [] {
+        auto const& uniform = uniform_type_name(typeid(Ts));
+        BOOST_TEST(static_type_name<Ts>() == uniform);
+        BOOST_TEST(static_friendly_name<Ts>() ==
+                   friendlyname::friendlyName(uniform));
+      }(),
+      ...);
+  }
+}
+
+static_assert(has_static_type_name_v<int>);
+static_assert(has_static_type_name_v<Hit>);
+static_assert(has_static_type_name_v<arttest::Kind>);
+static_assert(has_static_type_name_v<std::vector<Ptr<Hit>>>);
+static_assert(has_static_type_name_v<Wrapper<Assns<Hit, Track, double>>>);
+static_assert(!has_static_type_name_v<Hidden>);
+static_assert(!has_static_type_name_v<Hit const>);
+static_assert(!has_static_type_name_v<arttest::Holder<int>>);
+static_assert(!has_static_type_name_v<std::tuple<int>>);
+static_assert(!has_static_type_name_v<std::vector<Hidden>>);
+
+BOOST_AUTO_TEST_SUITE(static_type_name_t)
+
+BOOST_AUTO_TEST_CASE(fundamental_types)
+{
+  check_names<void,
+              bool,
+              char,
+              signed char,
+              unsigned char,
+              short,
+              unsigned short,
+              int,
+              unsigned int,
+              long,
+              unsigned long,
+              long long,
+              unsigned long long,
+              float,
+              double,
+              long double>();
+}
+
+BOOST_AUTO_TEST_CASE(classes)
+{
+  check_names<Hit,
+              arttest::Kind,
+              arttest::detail::Cluster,
+              std::string,
+              Hidden,
+              Hit const,
+              arttest::Holder<int>>();
+}
+
+BOOST_AUTO_TEST_CASE(standard_templates)
+{
+  check_names<std::vector<int>,
+              std::vector<bool>,
+              std::vector<std::vector<unsigned long long>>,
+              std::vector<std::string>,
+              std::map<std::string, std::vector<double>>,
+              std::map<long long, Hit>,
+              std::pair<int, unsigned long>,
+              std::set<std::string>,
+              std::vector<Hidden>,
+              std::vector<std::tuple<int, Hit>>,
+              std::array<int, 3>>();
+}
+
+BOOST_AUTO_TEST_CASE(art_templates)
+{
+  check_names<Ptr<Hit>,
+              PtrVector<Track>,
+              std::vector<Ptr<Hit>>,
+              Wrapper<std::vector<Hit>>,
+              Wrapper<std::vector<std::vector<Ptr<Hit>>>>,
+              Assns<Hit, Track>,
+              Assns<Track, Hit>,
+              Assns<Hit, Track, std::string>,
+              Assns<Track, Hit, arttest::Holder<int>>,
+              Wrapper<Assns<Hit, Track, double>>>();
+}
+
+BOOST_AUTO_TEST_CASE(assns_class_name)
+{
+  Assns<Hit, Track> const assns;
+  BOOST_TEST(assns.className() == TypeID{typeid(assns)}.className());
+}
+
+BOOST_AUTO_TEST_CASE(type_label)
+{
+  using product_t = std::vector<Ptr<Hit>>;
+  TypeLabel const runtime{TypeID{typeid(product_t)}, "instance", false};
+  TypeLabel const compiled{std::in_place_type<product_t>, "instance", false};
+  BOOST_TEST(compiled.typeID() == runtime.typeID());
+  BOOST_TEST(compiled.className() == runtime.className());
+  BOOST_TEST(compiled.friendlyClassName() == runtime.friendlyClassName());
+  BOOST_TEST(&compiled.className() == &static_type_name<product_t>());
+  BOOST_TEST(!(compiled < runtime));
+  BOOST_TEST(!(runtime < compiled));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+// vim: set sw=2 expandtab :
+
+// Times uniform_type_name() over a corpus of type names as demangled
+// from GCC (libstdc++) and Clang (libc++) type_info objects, repeated
+// N times, N given on the command line (default: 20000).
+
+#include "canvas/Utilities/uniform_type_name.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace art;
+
+namespace {
+
+  std::vector<std::string> const gcc_names{
+    "int",
+    "unsigned long long",
+    "std::__cxx11::basic_string<char, std::char_traits<char>, "
+    "std::allocator<char> >",
+    "std::vector<int, std::allocator<int> >",
+    "std::vector<std::__cxx11::basic_string<char, std::char_traits<char>, "
+    "std::allocator<char> >, std::allocator<std::__cxx11::basic_string<char, "
+    "std::char_traits<char>, std::allocator<char> > > >",
+    "std::map<std::__cxx11::basic_string<char, std::char_traits<char>, "
+    "std::allocator<char> >, std::vector<int, std::allocator<int> >, "
+    "std::less<std::__cxx11::basic_string<char, std::char_traits<char>, "
+    "std::allocator<char> > >, std::allocator<std::pair<std::__cxx11::"
+    "basic_string<char, std::char_traits<char>, std::allocator<char> > "
+    "const, std::vector<int, std::allocator<int> > > > >",
+    "std::vector<std::vector<unsigned long long, std::allocator<unsigned "
+    "long long> >, std::allocator<std::vector<unsigned long long, "
+    "std::allocator<unsigned long long> > > >",
+    "art::Wrapper<std::vector<art::Ptr<recob::Hit>, "
+    "std::allocator<art::Ptr<recob::Hit> > > >",
+    "art::Assns<recob::Track, recob::Hit, void>",
+    "cet::map_vector<std::pair<cet::map_vector_key, sim::Particle> >",
+    "std::set<std::pair<long long, ns::A const*>, std::less<std::pair<long "
+    "long, ns::A const*> >, std::allocator<std::pair<long long, ns::A "
+    "const*> > >",
+    "std::array<int, 3ul>"};
+
+  std::vector<std::string> const clang_names{
+    "std::__1::basic_string<char, std::__1::char_traits<char>, "
+    "std::__1::allocator<char> >",
+    "std::__1::vector<int, std::__1::allocator<int> >",
+    "std::__1::vector<std::__1::basic_string<char, "
+    "std::__1::char_traits<char>, std::__1::allocator<char> >, "
+    "std::__1::allocator<std::__1::basic_string<char, "
+    "std::__1::char_traits<char>, std::__1::allocator<char> > > >",
+    "std::__1::map<int, std::__1::vector<unsigned long long, "
+    "std::__1::allocator<unsigned long long> >, std::__1::less<int>, "
+    "std::__1::allocator<std::__1::pair<int const, std::__1::vector<unsigned "
+    "long long, std::__1::allocator<unsigned long long> > > > >",
+    "art::Wrapper<std::__1::vector<art::Ptr<recob::Hit>, "
+    "std::__1::allocator<art::Ptr<recob::Hit> > > >",
+    "cet::map_vector<std::__1::pair<cet::map_vector_key, sim::Particle> >",
+    "std::__1::array<int, 3ul>"};
+
+  double
+  ns_per_name(std::vector<std::string> const& names, unsigned const repeats)
+  {
+    std::size_t sink{};
+    auto const start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i != repeats; ++i) {
+      for (auto const& name : names) {
+        sink += uniform_type_name(name).size();
+      }
+    }
+    std::chrono::duration<double, std::nano> const elapsed{
+      std::chrono::steady_clock::now() - start};
+    if (sink == 0) {
+      std::cerr << "No names produced.\n";
+    }
+    return elapsed.count() / (double(repeats) * names.size());
+  }
+
+} // unnamed namespace
+
+int
+main(int argc, char** argv)
+{
+  unsigned const repeats =
+    argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20'000;
+  for (auto const& [label, names] :
+       {std::pair{"gcc  ", &gcc_names}, std::pair{"clang", &clang_names}}) {
+    std::cout << label << "  " << std::fixed << std::setprecision(1)
+              << std::setw(10) << ns_per_name(*names, repeats)
+              << " ns/name\n";
+  }
+}
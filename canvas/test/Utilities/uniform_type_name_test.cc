@@ -47,4 +47,27 @@ BOOST_AUTO_TEST_CASE(int_type_names)
          "MyULongTemplate_t<4,std::string>");
 }
 
+BOOST_AUTO_TEST_CASE(inline_namespaces)
+{
+  BOOST_TEST(uniform_type_name(
+               "std::__1::vector<std::__1::basic_string<char, "
+               "std::__1::char_traits<char>, std::__1::allocator<char> >, "
+               "std::__1::allocator<std::__1::basic_string<char, "
+               "std::__1::char_traits<char>, std::__1::allocator<char> > > "
+               ">") == "std::vector<std::string>");
+  BOOST_TEST(uniform_type_name(
+               "std::__1::map<int, std::__1::vector<unsigned long long, "
+               "std::__1::allocator<unsigned long long> >, "
+               "std::__1::less<int>, std::__1::allocator<std::__1::pair<int "
+               "const, std::__1::vector<unsigned long long, "
+               "std::__1::allocator<unsigned long long> > > > >") ==
+             "std::map<int,std::vector<ULong64_t> >");
+}
+
+BOOST_AUTO_TEST_CASE(unclosed_parameter)
+{
+  BOOST_TEST(uniform_type_name("std::vector<int, std::allocator<int>") ==
+             "std::vector<int");
+}
+
 BOOST_AUTO_TEST_SUITE_END()